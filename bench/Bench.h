@@ -0,0 +1,157 @@
+/**
+ * @file Bench.h
+ *
+ * @brief Cycle counter and console for the benchmark firmwares.
+ *
+ * @details The cycle counter is a free running 16 bit timer without prescaler:
+ * - ATmega328P: Timer1
+ * - megaAVR 0-series and tinyAVR 1-series: TCB0
+ *
+ * The results are printed via USART0 (stdout) at 1 MBaud 8N1.
+ * Measure only code running less than 65536 clock cycles.
+ * With EXT_PACK_TIMEBASE = 1 the library uses the same counter for its microsecond clock,
+ * its overflow interrupt (every 65536 clock cycles) may raise single maximum values.
+ * finish_bench() stops the controller which also ends the simulation in simavr.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_BENCH_H
+#define EXTPACK_BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+/**
+ * @brief Min, max and mean of measured cycle counts.
+ */
+typedef struct {
+    uint16_t min;   /**< Minimum cycles */
+    uint16_t max;   /**< Maximum cycles */
+    uint32_t sum;   /**< Sum of all measured cycles */
+    uint16_t count; /**< Amount of measurements */
+} bench_result_t;
+
+/**
+ * @brief Cycles needed to read the cycle counter twice. Subtracted from every measurement.
+ */
+static uint16_t bench_overhead_cycles = 0;
+
+/**
+ * @brief Returns the current value of the cycle counter.
+ */
+static inline uint16_t get_bench_cycles() {
+#ifdef __AVR_ATmega328P__
+    return TCNT1;
+#else
+    return TCB0.CNT;
+#endif
+}
+
+/**
+ * @brief Adds a measurement to a result.
+ *
+ * @param result The result to update.
+ * @param cycles The measured cycles.
+ */
+static inline void add_bench_result(bench_result_t* result, uint16_t cycles) {
+    if (result->count == 0 || cycles < result->min) {
+        result->min = cycles;
+    }
+    if (cycles > result->max) {
+        result->max = cycles;
+    }
+    result->sum += cycles;
+    result->count++;
+}
+
+/**
+ * @def BENCH_MEASURE
+ * @brief Measures the cycles of the given code and adds them to the result.
+ *
+ * @note Only accesses to volatile variables and calls of not inlined functions are ordered against the cycle counter reads.
+ */
+#define BENCH_MEASURE(result, code) do { \
+        uint16_t bench_start = get_bench_cycles(); \
+        code; \
+        uint16_t bench_end = get_bench_cycles(); \
+        add_bench_result(&(result), bench_end - bench_start - bench_overhead_cycles); \
+    } while (0)
+
+static int bench_putchar(char c, FILE* stream) {
+#ifdef __AVR_ATmega328P__
+    while (!(UCSR0A & (1<<UDRE0)));
+    UDR0 = c;
+#else
+    while (!(USART0.STATUS & USART_DREIF_bm));
+    USART0.TXDATAL = c;
+#endif
+    return 0;
+}
+
+static FILE bench_stdout = FDEV_SETUP_STREAM(bench_putchar, NULL, _FDEV_SETUP_WRITE);
+
+/**
+ * @brief Starts the cycle counter, opens the console and measures the counter overhead.
+ */
+static inline void init_bench() {
+#ifdef __AVR_ATmega328P__
+    TCCR1A = 0;
+    TCCR1B = (1<<CS10); // No prescaler
+    UBRR0 = (F_CPU/(1000000UL*16UL))-1;
+    UCSR0B = (1<<TXEN0);
+#else
+    uint8_t temp = CLKCTRL.MCLKCTRLB & ~CLKCTRL_PEN_bm; // Disable global clk Prescaler
+    CCP = 0xD8; // Disable change protection of Prescaler to write data
+    CLKCTRL.MCLKCTRLB = temp;
+    TCB0.CCMP = 0xFFFF;
+    TCB0.CTRLA = TCB_CLKSEL_CLKDIV1_gc | TCB_ENABLE_bm; // Periodic interrupt mode (default) without prescaler
+    USART0.BAUD = (uint16_t)((64UL*F_CPU)/(1000000UL*16UL));
+    USART0.CTRLB = USART_TXEN_bm;
+    #if defined(__AVR_ATtiny212__) || defined(__AVR_ATtiny412__)
+    PORTA_DIRSET = PIN6_bm;
+    #elif defined(__AVR_ATtiny416__) || defined(__AVR_ATtiny816__)
+    PORTB_DIRSET = PIN2_bm;
+    #else
+    PORTA_DIRSET = PIN0_bm;
+    #endif
+#endif
+    stdout = &bench_stdout;
+    bench_result_t overhead = {0};
+    BENCH_MEASURE(overhead, );
+    bench_overhead_cycles = overhead.min;
+}
+
+/**
+ * @brief Prints a result as one line: name, min, mean and max cycles.
+ *
+ * @param name The name of the measured code.
+ * @param result The result to print.
+ */
+static inline void print_bench_result(const char* name, const bench_result_t* result) {
+    uint16_t mean = result->count > 0 ? (uint16_t)(result->sum / result->count) : 0;
+    printf("%-40s min %5u mean %5u max %5u cycles (%u runs)\n", name, result->min, mean, result->max, result->count);
+}
+
+/**
+ * @brief Waits until the console output is sent and stops the controller.
+ *
+ * @details Sleeping with disabled interrupts ends the simulation in simavr.
+ */
+static inline void finish_bench() {
+#ifdef __AVR_ATmega328P__
+    while (!(UCSR0A & (1<<UDRE0)));
+#else
+    while (!(USART0.STATUS & USART_DREIF_bm));
+#endif
+    cli();
+    sleep_enable();
+    sleep_cpu();
+    while (1);
+}
+
+#endif //EXTPACK_BENCH_H
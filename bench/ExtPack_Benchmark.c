@@ -0,0 +1,143 @@
+/**
+ * @file ExtPack_Benchmark.c
+ *
+ * This benchmark measures the clock cycles of the hot paths of the library (linked against libExtPack.a):
+ * - _send_to_ExtPack per command pair (send buffer not full)
+ * - send_String_to_ExtPack per byte (without delay between the bytes)
+ * - process_received_ExtPack_data per received command pair (with and without custom ISR)
+ * - set_ExtPack_event, get_ExtPack_event, clear_ExtPack_event and get_next_ExtPack_event (only the last used unit pending)
+ * - enter_critical_zone + exit_critical_zone (nested, as in a custom ISR)
+ *
+ * With `EXT_PACK_UNIT_CONFIG_DIR=bench` the units are configured by ExtPack_Unit_Config.h and the received
+ * command pairs are processed by the generated switch instead of the units table.
+ *
+ * The sending is measured with disabled interrupts so the data register empty ISR does not distort the results.
+ * With SEND_BUF_LEN = 0 only one command pair fits at a time, so every send is followed by waiting for the UART.
+ */
+
+#include <stddef.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/delay.h>
+
+#include "Bench.h"
+#include "ExtPack/Core/ExtPack_Events.h"
+#include "ExtPack/Core/ExtPack_Internal.h"
+#include "ExtPack/Service/ExtPack_Advanced.h"
+
+#define ROUNDS 50
+#define BENCH_UNIT unit_U03        // Without custom ISR
+#define BENCH_ISR_UNIT unit_U04    // With custom ISR (bench_custom_ISR)
+
+#ifndef SEND_BUF_LEN
+    #define BENCH_BURST 10 // Default send buffer length of the microcontroller HALs
+#elif SEND_BUF_LEN > 0
+    #define BENCH_BURST SEND_BUF_LEN
+#else
+    #define BENCH_BURST 1
+#endif
+
+volatile uint8_t custom_ISR_calls = 0;
+
+void bench_custom_ISR(unit_t unit, uint8_t data) {
+    custom_ISR_calls++;
+}
+
+/*
+ * Waits until all command pairs of a burst are sent.
+ */
+static void wait_for_burst_sent() {
+    for (uint8_t i = 0; i < BENCH_BURST; i++) {
+        _delay_us(25);
+    }
+}
+
+int main() {
+    init_bench();
+    init_ExtPack(NULL, NULL, NULL);
+    printf("ExtPack benchmark (F_CPU = %lu Hz, send burst = %u, static units = %u)\n", F_CPU, BENCH_BURST, EXT_PACK_STATIC_UNITS);
+
+    // ---------- _send_to_ExtPack ----------
+    bench_result_t send_result = {0};
+    for (uint8_t round = 0; round < ROUNDS; round++) {
+        cli();
+        for (uint8_t i = 0; i < BENCH_BURST; i++) {
+            BENCH_MEASURE(send_result, _send_to_ExtPack(BENCH_UNIT, i));
+        }
+        sei();
+        wait_for_burst_sent();
+    }
+    print_bench_result("_send_to_ExtPack", &send_result);
+
+    // ---------- send_String_to_ExtPack ----------
+    uint8_t string[BENCH_BURST + 1];
+    for (uint8_t i = 0; i < BENCH_BURST; i++) {
+        string[i] = 'a' + i;
+    }
+    string[BENCH_BURST] = '\0';
+    bench_result_t string_result = {0};
+    for (uint8_t round = 0; round < ROUNDS; round++) {
+        cli();
+        BENCH_MEASURE(string_result, send_String_to_ExtPack(BENCH_UNIT, string, 0));
+        sei();
+        wait_for_burst_sent();
+    }
+    string_result.min /= BENCH_BURST;
+    string_result.max /= BENCH_BURST;
+    string_result.sum /= BENCH_BURST;
+    print_bench_result("send_String_to_ExtPack (per byte)", &string_result);
+
+    // ---------- process_received_ExtPack_data ----------
+    bench_result_t recv_result = {0};
+#if !EXT_PACK_STATIC_UNITS
+    init_ExtPack_Unit(BENCH_UNIT, EXTPACK_UART_UNIT, NULL);
+    init_ExtPack_Unit(BENCH_ISR_UNIT, EXTPACK_UART_UNIT, bench_custom_ISR);
+#endif
+    for (uint8_t round = 0; round < ROUNDS; round++) {
+        BENCH_MEASURE(recv_result, process_received_ExtPack_data(BENCH_UNIT, round));
+    }
+    print_bench_result("process_received_ExtPack_data", &recv_result);
+    bench_result_t recv_isr_result = {0};
+    for (uint8_t round = 0; round < ROUNDS; round++) {
+        BENCH_MEASURE(recv_isr_result, process_received_ExtPack_data(BENCH_ISR_UNIT, round));
+    }
+    dispatch_ExtPack_received(); // Only needed with RECV_BUF_LEN > 0
+    print_bench_result("process_received_ExtPack_data (ISR)", &recv_isr_result);
+
+    // ---------- Events ----------
+    bench_result_t set_result = {0};
+    bench_result_t get_result = {0};
+    bench_result_t clear_result = {0};
+    volatile uint8_t event;
+    for (uint8_t round = 0; round < ROUNDS; round++) {
+        unit_t unit = round % USED_UNITS;
+        BENCH_MEASURE(set_result, set_ExtPack_event(unit));
+        BENCH_MEASURE(get_result, event = get_ExtPack_event(unit));
+        BENCH_MEASURE(clear_result, clear_ExtPack_event(unit));
+    }
+    bench_result_t next_result = {0};
+    volatile unit_t next_unit;
+    reset_ExtPack_events();
+    set_ExtPack_event(USED_UNITS - 1);
+    for (uint8_t round = 0; round < ROUNDS; round++) {
+        BENCH_MEASURE(next_result, next_unit = get_next_ExtPack_event());
+    }
+    (void)event;
+    (void)next_unit;
+    print_bench_result("set_ExtPack_event", &set_result);
+    print_bench_result("get_ExtPack_event", &get_result);
+    print_bench_result("clear_ExtPack_event", &clear_result);
+    print_bench_result("get_next_ExtPack_event (worst case)", &next_result);
+
+    // ---------- Critical zones ----------
+    bench_result_t critical_result = {0};
+    for (uint8_t round = 0; round < ROUNDS; round++) {
+        uint8_t outer_state = enter_critical_zone(); // Interrupts already disabled like in a custom ISR
+        BENCH_MEASURE(critical_result, exit_critical_zone(enter_critical_zone()));
+        exit_critical_zone(outer_state);
+    }
+    print_bench_result("enter + exit_critical_zone (nested)", &critical_result);
+
+    printf("Benchmark finished\n");
+    finish_bench();
+}
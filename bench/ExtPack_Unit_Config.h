@@ -0,0 +1,28 @@
+/**
+ * @file ExtPack_Unit_Config.h
+ *
+ * @brief Static unit configuration of the benchmarks (used with `make bench EXT_PACK_UNIT_CONFIG_DIR=bench`).
+ *
+ * @details Configures the same units as ExtPack_Benchmark.c does at runtime without EXT_PACK_STATIC_UNITS,
+ * so both receive paths (units table + indirect call and generated switch) can be compared.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_BENCH_UNIT_CONFIG_H
+#define EXTPACK_BENCH_UNIT_CONFIG_H
+
+#include <stddef.h>
+#include "ExtPack/Core/ExtPack_Defs.h"
+
+void bench_custom_ISR(unit_t unit, uint8_t data);
+
+#define EXT_PACK_UNITS(UNIT) \
+    UNIT(unit_U00, EXTPACK_RESET_UNIT, NULL) \
+    UNIT(unit_U01, EXTPACK_ERROR_UNIT, NULL) \
+    UNIT(unit_U02, EXTPACK_ACK_UNIT, NULL) \
+    UNIT(unit_U03, EXTPACK_UART_UNIT, NULL) \
+    UNIT(unit_U04, EXTPACK_UART_UNIT, bench_custom_ISR)
+
+#endif //EXTPACK_BENCH_UNIT_CONFIG_H
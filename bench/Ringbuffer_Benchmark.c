@@ -0,0 +1,153 @@
+/**
+ * @file Ringbuffer_Benchmark.c
+ *
+ * This benchmark compares the send ringbuffer used before the compile-time specialized ringbuffers
+ * (runtime length, modulo and critical zone) with the ringbuffers generated by DEFINE_RINGBUFFER().
+ *
+ * For every implementation it measures the cycles of
+ * - adding a command pair to the buffer (send_UART_ExtPack_command) and
+ * - the body of the data register empty ISR (one call per sent byte and one call disabling the interrupt).
+ *
+ * The same measurements are done for a capacity of 10 (default, wrapped with a compare) and 16 (power of two, masked).
+ * The UART data register is replaced by a variable so the ISR bodies can be called directly.
+ */
+
+#include <avr/io.h>
+#include "Bench.h"
+#include "ExtPack/Core/ExtPack_Ringbuffer_Internal.h"
+
+#define ROUNDS 50
+
+volatile uint8_t bench_udr;             // Replaces the UART data register
+volatile uint8_t bench_dre_enabled;     // Replaces the data register empty interrupt enable bit
+
+// ---------------------------------- Old ringbuffer ----------------------------------
+
+typedef struct {
+    volatile uint16_t* data;
+    uint8_t buf_len;
+    uint8_t free_slots;
+    uint8_t next_read_slot_index;
+    uint8_t next_write_slot_index;
+} old_ringbuffer_metadata_t;
+
+volatile uint8_t old_sreg_save;
+
+__attribute__((noinline)) void old_enter_critical_zone() {
+    old_sreg_save = SREG;
+    __asm__ __volatile__("cli" ::: "memory");
+}
+
+__attribute__((noinline)) void old_exit_critical_zone() {
+    SREG = old_sreg_save;
+}
+
+__attribute__((noinline)) ext_pack_error_t old_write_buf(volatile old_ringbuffer_metadata_t* metadata, uint16_t data) {
+    old_enter_critical_zone();
+    if(metadata->free_slots == 0) {
+        old_exit_critical_zone();
+        return EXT_PACK_FAILURE;
+    }
+    metadata->data[metadata->next_write_slot_index] = data;
+    metadata->next_write_slot_index = (metadata->next_write_slot_index + 1) % metadata->buf_len;
+    metadata->free_slots--;
+    old_exit_critical_zone();
+    return EXT_PACK_SUCCESS;
+}
+
+__attribute__((noinline)) ext_pack_error_t old_read_buf(volatile old_ringbuffer_metadata_t* metadata, uint16_t* data) {
+    old_enter_critical_zone();
+    if (metadata->free_slots == metadata->buf_len) {
+        old_exit_critical_zone();
+        return EXT_PACK_FAILURE; // Error, nothing to read
+    }
+    uint8_t current_read_index = metadata->next_read_slot_index;
+    metadata->next_read_slot_index = (metadata->next_read_slot_index + 1) % metadata->buf_len;
+    metadata->free_slots++;
+    *data = metadata->data[current_read_index];
+    old_exit_critical_zone();
+    return EXT_PACK_SUCCESS;
+}
+
+volatile uint16_t old_buf_10_data[10];
+volatile old_ringbuffer_metadata_t old_buf_10 = { old_buf_10_data, 10, 10, 0, 0 };
+volatile uint16_t old_buf_16_data[16];
+volatile old_ringbuffer_metadata_t old_buf_16 = { old_buf_16_data, 16, 16, 0, 0 };
+
+// ---------------------------------- New ringbuffers ----------------------------------
+
+DEFINE_RINGBUFFER(new_buf_10, uint16_t, 10)
+volatile new_buf_10_t new_buf_10;
+DEFINE_RINGBUFFER(new_buf_16, uint16_t, 16)
+volatile new_buf_16_t new_buf_16;
+
+// ------------------------------ Send function and ISR bodies ------------------------------
+
+volatile uint8_t next_data_to_send;
+volatile uint8_t next_data_to_send_is_buffer_pair = 1;
+
+/*
+ * Generates the buffer part of send_UART_ExtPack_command and the data register empty ISR body of the HALs for one ringbuffer.
+ */
+#define DEFINE_BENCH_SEND_AND_DRE(name, write_call, read_call, empty_call) \
+    __attribute__((noinline)) ext_pack_error_t name##_send(unit_t unit, uint8_t data) { \
+        uint16_t buf_data = ((uint16_t)unit<<8) | data; \
+        ext_pack_error_t ret = write_call; \
+        bench_dre_enabled = 1; \
+        return ret; \
+    } \
+    __attribute__((noinline)) void name##_dre_isr() { \
+        if(next_data_to_send_is_buffer_pair) { \
+            uint16_t data; \
+            if(read_call == EXT_PACK_SUCCESS) { \
+                bench_udr = (uint8_t)(data >> 8); \
+                next_data_to_send = (uint8_t)data; \
+                next_data_to_send_is_buffer_pair = 0; \
+            } else { \
+                bench_dre_enabled = 0; \
+            } \
+        } else { \
+            next_data_to_send_is_buffer_pair = 1; \
+            bench_udr = next_data_to_send; \
+            if (empty_call) { \
+                bench_dre_enabled = 0; \
+            } \
+        } \
+    }
+
+DEFINE_BENCH_SEND_AND_DRE(old_10, old_write_buf(&old_buf_10, buf_data), old_read_buf(&old_buf_10, &data), old_buf_10.free_slots == old_buf_10.buf_len)
+DEFINE_BENCH_SEND_AND_DRE(old_16, old_write_buf(&old_buf_16, buf_data), old_read_buf(&old_buf_16, &data), old_buf_16.free_slots == old_buf_16.buf_len)
+DEFINE_BENCH_SEND_AND_DRE(new_10, write_new_buf_10(&new_buf_10, buf_data), read_new_buf_10(&new_buf_10, &data), is_new_buf_10_empty(&new_buf_10))
+DEFINE_BENCH_SEND_AND_DRE(new_16, write_new_buf_16(&new_buf_16, buf_data), read_new_buf_16(&new_buf_16, &data), is_new_buf_16_empty(&new_buf_16))
+
+/*
+ * Fills the buffer completely and drains it with the ISR body ROUNDS times.
+ */
+static void run_benchmark(const char* name, uint8_t capacity, ext_pack_error_t (*send)(unit_t, uint8_t), void (*dre_isr)()) {
+    bench_result_t send_result = {0};
+    bench_result_t dre_result = {0};
+    for (uint8_t round = 0; round < ROUNDS; round++) {
+        for (uint8_t i = 0; i < capacity; i++) {
+            BENCH_MEASURE(send_result, send(unit_U03, i));
+        }
+        while (bench_dre_enabled) {
+            BENCH_MEASURE(dre_result, dre_isr());
+        }
+    }
+    printf("%s\n", name);
+    print_bench_result("  send_UART_ExtPack_command (buffer part)", &send_result);
+    print_bench_result("  DRE ISR body", &dre_result);
+}
+
+int main() {
+    init_bench();
+    init_new_buf_10(&new_buf_10);
+    init_new_buf_16(&new_buf_16);
+    printf("Ringbuffer benchmark (F_CPU = %lu Hz)\n", F_CPU);
+    run_benchmark("Old ringbuffer, length 10 (modulo)", 10, old_10_send, old_10_dre_isr);
+    run_benchmark("New ringbuffer, capacity 10 (compare)", 10, new_10_send, new_10_dre_isr);
+    run_benchmark("Old ringbuffer, length 16 (modulo)", 16, old_16_send, old_16_dre_isr);
+    run_benchmark("New ringbuffer, capacity 16 (mask)", 16, new_16_send, new_16_dre_isr);
+    printf("Benchmark finished\n");
+    finish_bench();
+}
@@ -10,6 +10,7 @@
  * Additionally, interrupts have to disabled in the UART ISR as there could be race conditions when setting the SRAM address.
  *
  * The Reset unit resets the microcontroller whenever the ExtPack is reset and the ExtPack when the microcontroller was reset.
+ * The SRAM data is sent back by an event handler called in the main loop.
  */
 
 #include <avr/io.h>
@@ -17,10 +18,10 @@
 #include <stddef.h>
 #include <util/delay.h>
 
-#include "ExtPack/Core/ExtPack_Events.h"
 #include "ExtPack/Util/ExtPack_U_Reset.h"
 #include "ExtPack/Util/ExtPack_U_UART.h"
 #include "ExtPack/Service/ExtPack_U_SRAM_Advanced.h"
+#include "ExtPack/Service/ExtPack_Event_Loop.h"
 #include "ExtPack/Util/Dynamic_Delay.h"
 
 
@@ -30,6 +31,7 @@
 
 void reset_unit_custom_ISR(unit_t unit, uint8_t data);
 void UART_unit_custom_ISR(unit_t unit, uint8_t data);
+void SRAM_unit_event_handler(unit_t unit, uint8_t data);
 
 int main() {
 #ifndef __AVR_ATmega328P__
@@ -43,14 +45,17 @@ int main() {
     reset_ExtPack();
     _delay_us(100); // Wait for the ExtPack to send his reset request (which would reset this microcontroller)
     set_ExtPack_custom_ISR(RESET_UNIT, reset_unit_custom_ISR);
+    set_ExtPack_event_handler(SRAM_UNIT, SRAM_unit_event_handler, 0);
     while (1) {
-        if (get_ExtPack_event(SRAM_UNIT)) {
-            send_ExtPack_UART_data(UART_UNIT, get_last_received_ExtPack_SRAM_data(SRAM_UNIT));
-            clear_ExtPack_event(SRAM_UNIT);
-        }
+        run_ExtPack_events(4);
     }
 }
 
+void SRAM_unit_event_handler(unit_t unit, uint8_t data) {
+    // SRAM data received
+    send_ExtPack_UART_data(UART_UNIT, data);
+}
+
 void reset_unit_custom_ISR(unit_t unit, uint8_t data) {
     // ExtPack was reset
     if (data == 0xFF) {
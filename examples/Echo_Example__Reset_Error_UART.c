@@ -3,7 +3,8 @@
  *
  * This example shows the usage of the UART unit in combination with the Reset and Error unit.
  * The example sends all received data back to the UART sender.
- * If there is an error in the communication "ERROR\n" is sent via UART.
+ * If there is an error in the communication "ERROR\n" is sent via UART with 10 ms between the bytes.
+ * With the compiler flag `-DEXT_PACK_PACED_JOBS=1` it is sent without blocking (paced send), otherwise the error ISR blocks while sending.
  *
  * The Reset unit resets the microcontroller whenever the ExtPack is reset and the ExtPack when the microcontroller was reset.
  */
@@ -52,9 +53,15 @@ void reset_unit_custom_ISR(unit_t unit, uint8_t data) {
 }
 
 void error_unit_custom_ISR(unit_t unit, uint8_t data) {
+#if EXT_PACK_PACED_JOBS > 0
+    // An error occurred --> Sent in the background by the pace timer (skipped if the last one is still running)
+    static const uint8_t error_string[6] = "ERROR\n";
+    start_ExtPack_paced_send(UART_Unit, error_string, sizeof(error_string), 10000);
+#else
     // An error occurred
     uint8_t error_string[7] = "ERROR\n";
     send_ExtPack_UART_String(UART_Unit, error_string, 10000);
+#endif
 }
 
 void UART_unit_custom_ISR(unit_t unit, uint8_t data) {
@@ -5,6 +5,7 @@
  * As communication partner an DS3231 real time clock is used.
  * The example reads the RTC registers with an one second delay and sends the result as readable chars via UART.
  * Acknowledgements are used to ensure the ExtPack receives the commands.
+ * The register reads wait for the ACKs with the adaptive timeout of the I2C unit type (see send_ExtPack_acknowledged()).
  *
  * The Reset unit resets the microcontroller whenever the ExtPack is reset and the ExtPack when the microcontroller was reset.
  */
@@ -49,14 +50,9 @@ int main() {
     while(1) {
         // Read all RTC registers every second
         for (uint8_t temp = 0; temp < 7; temp++) {
-            clear_ExtPack_ack_event();
-            do {
-                send_ExtPack_I2C_data(I2C_UNIT, temp);
-            } while (wait_for_ExtPack_ACK_data(temp, 100) != EXT_PACK_SUCCESS);
-            clear_ExtPack_ack_event();
-            do {
-                receive_ExtPack_I2C_data(I2C_UNIT);
-            } while (wait_for_ExtPack_ACK_data(0x00, 100) != EXT_PACK_SUCCESS);
+            // Register address (send_ExtPack_I2C_data) and read request (receive_ExtPack_I2C_data)
+            while (send_ExtPack_acknowledged(I2C_UNIT, 0b00, temp, 3) != EXT_PACK_SUCCESS);
+            while (send_ExtPack_acknowledged(I2C_UNIT, 0b10, 0x00, 3) != EXT_PACK_SUCCESS);
             _delay_us(500);
         }
         _delay_ms(1000);
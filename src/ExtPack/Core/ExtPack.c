@@ -1,25 +1,74 @@
 #include "ExtPack_Internal.h"
 #include "ExtPack_Events.h"
 #include "../HAL/ExtPack_LL.h"
+#include "ExtPack_Link_Stats_Internal.h"
+#include "ExtPack_Profiling_Internal.h"
+#include "ExtPack_Timebase_Internal.h"
+#if RECV_BUF_LEN > 0
+#include "ExtPack_Ringbuffer_Internal.h"
+#endif
 
 /**
  * @def NULL
  *
  * @brief Defines NULL as pointer to zero.
  */
+#ifndef NULL
 #define NULL (void*)0
+#endif
 
+#if EXT_PACK_STATIC_UNITS
+#define EXT_PACK_UNIT_SLOT_ENTRY(unit, unit_type, custom_ISR) [unit] = ext_pack_slot_##unit,
+const uint8_t unit_slots[USED_UNITS] PROGMEM = {
+    EXT_PACK_UNITS(EXT_PACK_UNIT_SLOT_ENTRY) // Not configured units stay 0
+};
+#else
 struct unit units[USED_UNITS] = {0};
+#endif
 
-struct unit_data_storage unit_data[USED_UNITS] = {0};
+struct unit_data_storage unit_data[EXT_PACK_UNIT_SLOTS] = {0};
+
+#if EXT_PACK_SHADOW_STATE
+/*
+ * Last sent configuration of every unit slot per access mode.
+ * The value of an access mode is only set if its bit in stored_modes is set
+ * and the ExtPack only has it (since the last reset) if its bit in current_modes is set.
+ */
+static struct shadow_state {
+    uint8_t values[4];
+    uint8_t stored_modes;
+    uint8_t current_modes;
+} shadow_states[EXT_PACK_UNIT_SLOTS];
+#endif
+
+#if RECV_BUF_LEN > 0
+/*
+ * Received command pairs (unit << 8 | data) waiting for their custom ISR.
+ * Written by the receive interrupt, read by dispatch_ExtPack_received().
+ */
+DEFINE_RINGBUFFER(recv_buf, uint16_t, RECV_BUF_LEN)
+volatile recv_buf_t recv_buf;
+#endif
 
 void init_ExtPack(void (*reset_ISR)(unit_t, uint8_t), void (*error_ISR)(unit_t, uint8_t), void (*ack_ISR)(unit_t, uint8_t)) {
+#if RECV_BUF_LEN > 0
+    init_recv_buf(&recv_buf);
+#endif
     init_ExtPack_LL();
+    set_ExtPack_timebase_running();
+#if EXT_PACK_STATIC_UNITS
+    // Reset, error and ACK units are configured in EXT_PACK_UNITS
+    (void)reset_ISR;
+    (void)error_ISR;
+    (void)ack_ISR;
+#else
     init_ExtPack_Unit(unit_U00, EXTPACK_RESET_UNIT, reset_ISR);
     init_ExtPack_Unit(unit_U01, EXTPACK_ERROR_UNIT, error_ISR);
     init_ExtPack_Unit(unit_U02, EXTPACK_ACK_UNIT, ack_ISR);
+#endif
 }
 
+#if !EXT_PACK_STATIC_UNITS
 void init_ExtPack_Unit(unit_t unit, unit_type_t unit_type, void (*custom_ISR)(unit_t, uint8_t)) {
     units[unit].unit_type = unit_type;
     units[unit].custom_ISR = custom_ISR;
@@ -28,26 +77,117 @@ void init_ExtPack_Unit(unit_t unit, unit_type_t unit_type, void (*custom_ISR)(un
 void set_ExtPack_custom_ISR(unit_t unit, void (*new_custom_ISR)(unit_t, uint8_t)) {
     units[unit].custom_ISR = new_custom_ISR;
 }
+#endif
+
+/*
+ * Calls the custom ISR of a unit if set.
+ */
+static inline void call_ExtPack_custom_ISR(void (*custom_ISR)(unit_t, uint8_t), unit_t unit, uint8_t data) {
+    if (custom_ISR != NULL) {
+        EXT_PACK_PROFILE_START(profile_start);
+        custom_ISR(unit, data);
+        EXT_PACK_PROFILE_UNIT_END(unit, profile_start);
+    }
+}
+
+/*
+ * Stores the received data of a valid unit in its slot, sets the event and calls or queues the custom ISR.
+ */
+static inline void receive_ExtPack_unit_data(unit_t unit, uint8_t slot, uint8_t data, void (*custom_ISR)(unit_t, uint8_t)) {
+    COUNT_EXT_PACK_LINK_STAT(frames_received);
+    unit_data[slot].input_values = data;
+#if EXT_PACK_SHADOW_STATE
+    if (unit == unit_U00) {
+        invalidate_ExtPack_configuration(); // ExtPack got reset --> Configuration lost
+    }
+#endif
+    set_ExtPack_event(unit);
+#if RECV_BUF_LEN > 0
+    // Defers the ISR of the unit to dispatch_ExtPack_received() (dropped if the receive buffer is full)
+    if (custom_ISR != NULL && write_recv_buf(&recv_buf, ((uint16_t)unit<<8) | data) == EXT_PACK_FAILURE) {
+        COUNT_EXT_PACK_LINK_STAT(rx_queue_full);
+    }
+#else
+    call_ExtPack_custom_ISR(custom_ISR, unit, data);
+#endif
+}
+
+#if EXT_PACK_STATIC_UNITS
+/*
+ * One case per configured unit with constant slot, unit type and custom ISR.
+ * Units with access mode bits set are above 63 and therefore never match.
+ */
+#define EXT_PACK_UNIT_RECEIVE_CASE(unit, unit_type, custom_ISR) \
+    case unit: \
+        if ((unit_type) == EXTPACK_UNDEFINED) { \
+            break; \
+        } \
+        receive_ExtPack_unit_data(unit, ext_pack_slot_##unit, data, custom_ISR); \
+        return;
 
+void process_received_ExtPack_data(unit_t unit, uint8_t data) {
+    switch (unit) {
+        EXT_PACK_UNITS(EXT_PACK_UNIT_RECEIVE_CASE)
+        default:
+            break;
+    }
+    COUNT_EXT_PACK_LINK_STAT(invalid_units); // Not configured, undefined or access mode bit set
+}
+
+#if RECV_BUF_LEN > 0
+#define EXT_PACK_UNIT_DISPATCH_CASE(unit, unit_type, custom_ISR) \
+    case unit: \
+        call_ExtPack_custom_ISR(custom_ISR, unit, data); \
+        break;
+
+/*
+ * Calls the custom ISR of a configured unit directly.
+ */
+static void dispatch_ExtPack_unit_data(unit_t unit, uint8_t data) {
+    switch (unit) {
+        EXT_PACK_UNITS(EXT_PACK_UNIT_DISPATCH_CASE)
+        default:
+            break;
+    }
+}
+#endif
+#else
 void process_received_ExtPack_data(unit_t unit, uint8_t data) {
     if(unit < USED_UNITS
         && !(unit & (1<<ACC_MODE1_BIT))
         && !(unit & (1<<ACC_MODE0_BIT)))
     {
         // Valid unit and no access mode bit set
-        void (*custom_ISR)(unit_t, uint8_t) = units[unit].custom_ISR;
-        switch (units[unit].unit_type) {
-            case EXTPACK_UNDEFINED:
-                return; // Ends receive because no unit type is chosen
-            default:
-                unit_data[unit].input_values = data;
-                set_ExtPack_event(unit);
-        }
-        if (custom_ISR != NULL) {
-            // Calls ISR of unit if set
-            custom_ISR(unit, data);
+        if (units[unit].unit_type == EXTPACK_UNDEFINED) {
+            COUNT_EXT_PACK_LINK_STAT(invalid_units);
+            return; // Ends receive because no unit type is chosen
         }
+        receive_ExtPack_unit_data(unit, unit, data, units[unit].custom_ISR);
+    } else {
+        COUNT_EXT_PACK_LINK_STAT(invalid_units);
+    }
+}
+
+#if RECV_BUF_LEN > 0
+/*
+ * Calls the custom ISR of a unit through the units table.
+ */
+static inline void dispatch_ExtPack_unit_data(unit_t unit, uint8_t data) {
+    call_ExtPack_custom_ISR(units[unit].custom_ISR, unit, data);
+}
+#endif
+#endif
+
+uint8_t dispatch_ExtPack_received() {
+    uint8_t amount_dispatched = 0;
+#if RECV_BUF_LEN > 0
+    uint16_t command;
+    while (read_recv_buf(&recv_buf, &command) == EXT_PACK_SUCCESS) {
+        dispatch_ExtPack_unit_data(command >> 8, (uint8_t)command);
+        amount_dispatched++;
     }
+#endif
+    return amount_dispatched;
 }
 
 /*
@@ -63,6 +203,168 @@ ext_pack_error_t _send_to_ExtPack(unit_t unit, uint8_t data) {
     return EXT_PACK_FAILURE;
 }
 
+ext_pack_error_t _send_coalesced_to_ExtPack(unit_t unit, uint8_t data) {
+#if EXT_PACK_TX_COALESCING
+    // ACK state in bit 0 of the ACK unit's output values
+    if ((unit & 0b00111111) < USED_UNITS && !(get_ExtPack_stored_unit_output_values(unit_U02) & 0x01)) {
+        return send_UART_ExtPack_command_coalesced(unit, data);
+    }
+#endif
+    return _send_to_ExtPack(unit, data);
+}
+
+#if EXT_PACK_SHADOW_STATE
+/*
+ * Returns the shadow state of the unit, NULL if the unit has none (not used or not configured with EXT_PACK_STATIC_UNITS).
+ */
+static inline struct shadow_state* get_ExtPack_shadow_state(unit_t unit) {
+    if ((unit & 0b00111111) >= USED_UNITS) {
+        return NULL;
+    }
+    uint8_t slot = get_ExtPack_unit_slot(unit & 0b00111111);
+#if EXT_PACK_STATIC_UNITS
+    if (slot == EXT_PACK_UNCONFIGURED_UNIT_SLOT) {
+        return NULL; // Shared by all not configured units
+    }
+#endif
+    return &shadow_states[slot];
+}
+#endif
+
+ext_pack_error_t _send_configuration_to_ExtPack(unit_t unit, uint8_t data) {
+#if EXT_PACK_SHADOW_STATE
+    // Check, send and store at once --> Custom ISRs can not send another value in between
+    uint8_t interrupt_state = enter_critical_zone();
+    // With ACK enabled every write is acknowledged --> Never skipped (ACK state in bit 0 of the ACK unit's output values)
+    if (!(get_ExtPack_stored_unit_output_values(unit_U02) & 0x01) && _is_ExtPack_configuration_current(unit, data)) {
+        exit_critical_zone(interrupt_state);
+        return EXT_PACK_SUCCESS; // ExtPack already has it
+    }
+    ext_pack_error_t ret = _send_coalesced_to_ExtPack(unit, data);
+    if (ret == EXT_PACK_SUCCESS) {
+        _update_ExtPack_configuration(unit, data);
+    }
+    exit_critical_zone(interrupt_state);
+    return ret;
+#else
+    return _send_coalesced_to_ExtPack(unit, data);
+#endif
+}
+
+uint8_t _is_ExtPack_configuration_current(unit_t unit, uint8_t data) {
+#if EXT_PACK_SHADOW_STATE
+    uint8_t access_mode = unit >> 6;
+    struct shadow_state* shadow_state = get_ExtPack_shadow_state(unit);
+    return shadow_state != NULL && (shadow_state->current_modes & (1 << access_mode)) && shadow_state->values[access_mode] == data;
+#else
+    return 0;
+#endif
+}
+
+void _update_ExtPack_configuration(unit_t unit, uint8_t data) {
+#if EXT_PACK_SHADOW_STATE
+    uint8_t access_mode = unit >> 6;
+    struct shadow_state* shadow_state = get_ExtPack_shadow_state(unit);
+    if (shadow_state != NULL) {
+        shadow_state->values[access_mode] = data;
+        shadow_state->stored_modes |= 1 << access_mode;
+        shadow_state->current_modes |= 1 << access_mode;
+    }
+#endif
+}
+
+void invalidate_ExtPack_configuration() {
+#if EXT_PACK_SHADOW_STATE
+    for (uint8_t slot = 0; slot < EXT_PACK_UNIT_SLOTS; slot++) {
+        shadow_states[slot].current_modes = 0; // Stored values are kept for restore_ExtPack_configuration()
+    }
+#endif
+}
+
+uint8_t _get_ExtPack_lost_configuration(unit_t unit, ext_pack_command_t* commands) {
+    uint8_t amount = 0;
+#if EXT_PACK_SHADOW_STATE
+    struct shadow_state* shadow_state = get_ExtPack_shadow_state(unit);
+    if (shadow_state == NULL) {
+        return 0;
+    }
+    uint8_t lost_modes = shadow_state->stored_modes & ~shadow_state->current_modes;
+    // Access mode 0b00 (enable) last --> P.ex. a timer is only enabled with its complete configuration
+    for (uint8_t i = 1; i <= 4; i++) {
+        uint8_t access_mode = i & 0b11;
+        if (access_mode == 0b00 && (lost_modes & 0b1100) && get_ExtPack_unit_type(unit) == EXTPACK_TIMER_UNIT) {
+            commands[amount++] = (ext_pack_command_t){ _set_ExtPack_access_mode(unit, 0b01), 0x00 }; // Restart with the start value
+        }
+        if (lost_modes & (1 << access_mode)) {
+            commands[amount++] = (ext_pack_command_t){ _set_ExtPack_access_mode(unit, access_mode), shadow_state->values[access_mode] };
+        }
+    }
+#endif
+    return amount;
+}
+
+void _set_ExtPack_configuration_restored(unit_t unit) {
+#if EXT_PACK_SHADOW_STATE
+    struct shadow_state* shadow_state = get_ExtPack_shadow_state(unit);
+    if (shadow_state != NULL) {
+        shadow_state->current_modes = shadow_state->stored_modes;
+    }
+#endif
+}
+
+uint8_t _send_block_to_ExtPack(unit_t unit, const uint8_t* data, uint8_t len) {
+    if ((unit & 0b00111111) < USED_UNITS) {
+        return send_UART_ExtPack_commands(unit, data, len);
+    }
+    return 0;
+}
+
+ext_pack_error_t _send_transaction_to_ExtPack(const ext_pack_command_t* commands, uint8_t amount) {
+    for (uint8_t i = 0; i < amount; i++) {
+        if ((commands[i].unit & 0b00111111) >= USED_UNITS) {
+            return EXT_PACK_FAILURE;
+        }
+    }
+    return send_UART_ExtPack_transaction(commands, amount);
+}
+
+uint8_t get_ExtPack_tx_capacity() {
+    return get_UART_ExtPack_tx_capacity();
+}
+
+uint8_t get_ExtPack_tx_free_slots() {
+    return get_UART_ExtPack_free_slots();
+}
+
+uint8_t is_ExtPack_tx_complete() {
+    return is_UART_ExtPack_tx_complete();
+}
+
+/*
+ * Called once when all command pairs are sent, NULL if nobody waits for it.
+ */
+static void (*volatile tx_complete_callback)() = NULL;
+
+void notify_ExtPack_tx_complete(void (*callback)()) {
+    uint8_t interrupt_state = enter_critical_zone();
+    if (is_UART_ExtPack_tx_complete()) {
+        exit_critical_zone(interrupt_state);
+        callback();
+        return;
+    }
+    tx_complete_callback = callback;
+    notify_UART_ExtPack_tx_complete();
+    exit_critical_zone(interrupt_state);
+}
+
+void process_ExtPack_tx_complete() {
+    void (*callback)() = tx_complete_callback;
+    tx_complete_callback = NULL;
+    if (callback != NULL) {
+        callback();
+    }
+}
+
 uint8_t get_ExtPack_send_duration_us() {
     /*
      * UART transmission itself:
@@ -33,6 +33,8 @@
  * @details This function enables USART0, Timer/Counter0 and global interrupts to be able to establish communication.
  * It also initializes unit_U00 as reset unit, unit_U01 as error unit, and unit_U02 as ACK unit with the given ISRs.
  *
+ * @note With EXT_PACK_STATIC_UNITS = 1 the ISRs are ignored, the units are configured by EXT_PACK_UNITS in ExtPack_Unit_Config.h.
+ *
  * @layer Core
  *
  * @param reset_ISR A pointer to the interrupt service routine (ISR) function
@@ -44,6 +46,7 @@
  */
 void init_ExtPack(void (*reset_ISR)(unit_t, uint8_t), void (*error_ISR)(unit_t, uint8_t), void (*ack_ISR)(unit_t, uint8_t));
 
+#if !EXT_PACK_STATIC_UNITS
 /**
  * @brief Initializes the specified ExtPack unit with the given parameters.
  *
@@ -67,6 +70,24 @@ void init_ExtPack_Unit(unit_t unit, unit_type_t unit_type, void (*custom_ISR)(un
  * @param new_custom_ISR The new custom ISR function which is called when an interrupt of the unit occurs.
  */
 void set_ExtPack_custom_ISR(unit_t unit, void (*new_custom_ISR)(unit_t, uint8_t));
+#endif
+
+/**
+ * @brief Calls the custom ISRs of all received command pairs waiting in the receive buffer.
+ *
+ * @layer Core
+ *
+ * @details Only used with RECV_BUF_LEN > 0 (deferred dispatch). Call it regularly in the main loop.
+ * The unit data and events are already updated when the command pair is received.
+ * The custom ISRs get the data of their command pair, even if newer data of the unit was received in the meantime.
+ *
+ * @note Does nothing with RECV_BUF_LEN = 0 as the custom ISRs are called directly in the receive interrupt.
+ *
+ * @warning Do not call it from a custom ISR or another ISR.
+ *
+ * @return The amount of dispatched command pairs.
+ */
+uint8_t dispatch_ExtPack_received();
 
 /**
  * @brief Sets the access mode of the unit to the given one.
@@ -91,6 +112,144 @@ inline unit_t _set_ExtPack_access_mode(unit_t unit, uint8_t access_mode) {
  */
 ext_pack_error_t _send_to_ExtPack(unit_t unit, uint8_t data);
 
+/**
+ * @brief Sends an idempotent command (only its newest data matters, p.ex. GPIO output values) "as is" to ExtPack via UART.
+ *
+ * @layer Core
+ *
+ * @details With EXT_PACK_TX_COALESCING = 1 the data replaces the data of the newest queued command if it has the same unit and access mode
+ * (see send_UART_ExtPack_command_coalesced()), so repeated writes do not queue stale values. Commands queued in between are never overtaken.
+ * While the ACK unit is enabled every command is appended as every command is acknowledged.
+ * With EXT_PACK_TX_COALESCING = 0 the same as _send_to_ExtPack().
+ *
+ * @param unit The ExtPack unit to which the data should be sent.
+ * @param data The data to be sent.
+ * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on failure.
+ */
+ext_pack_error_t _send_coalesced_to_ExtPack(unit_t unit, uint8_t data);
+
+/**
+ * @brief Sends a configuration (p.ex. SPI slave id or timer prescaler) to ExtPack via UART unless the ExtPack already has it.
+ *
+ * @layer Core
+ *
+ * @details With EXT_PACK_SHADOW_STATE = 1 the last sent data of every unit and access mode is stored (shadow state).
+ * Writes of the same data are skipped until the shadow state is invalidated (p.ex. by a reset of the ExtPack),
+ * except while the ACK unit is enabled. The configuration is sent with _send_coalesced_to_ExtPack().
+ *
+ * @param unit The ExtPack unit and access mode of the configuration.
+ * @param data The configuration value.
+ * @return EXT_PACK_SUCCESS if sent or skipped, EXT_PACK_FAILURE on failure.
+ */
+ext_pack_error_t _send_configuration_to_ExtPack(unit_t unit, uint8_t data);
+
+/**
+ * @brief Checks if the ExtPack already has the given configuration according to the shadow state.
+ *
+ * @layer Core
+ *
+ * @note Call it in a critical zone together with sending the dependent commands,
+ * so custom ISRs can not change the configuration in between.
+ *
+ * @param unit The ExtPack unit and access mode of the configuration.
+ * @param data The configuration value.
+ * @return 1 if the configuration does not have to be sent, 0 otherwise (always 0 with EXT_PACK_SHADOW_STATE = 0).
+ */
+uint8_t _is_ExtPack_configuration_current(unit_t unit, uint8_t data);
+
+/**
+ * @brief Stores a configuration sent without _send_configuration_to_ExtPack() (p.ex. in a transaction) in the shadow state.
+ *
+ * @layer Core
+ *
+ * @note Call it in the same critical zone as sending the configuration.
+ *
+ * @param unit The ExtPack unit and access mode of the configuration.
+ * @param data The configuration value.
+ */
+void _update_ExtPack_configuration(unit_t unit, uint8_t data);
+
+/**
+ * @brief Invalidates the shadow state of all units, so every configuration is sent again.
+ *
+ * @layer Core
+ *
+ * @details Called automatically when the ExtPack reports a reset and by reset_ExtPack().
+ * Call it if the ExtPack lost its configuration otherwise (p.ex. power cycle without reset message).
+ * The sent configuration is kept, restore_ExtPack_configuration() sends it again.
+ */
+void invalidate_ExtPack_configuration();
+
+/**
+ * @def EXT_PACK_MAX_RESTORE_COMMANDS
+ * @brief Maximum amount of commands to restore the configuration of one unit (4 access modes + timer restart).
+ *
+ * @layer Core
+ */
+#define EXT_PACK_MAX_RESTORE_COMMANDS 5
+
+/**
+ * @brief Returns the commands restoring the configuration of a unit the ExtPack lost (sent before, invalidated since).
+ *
+ * @layer Core
+ *
+ * @details The enable (access mode 0b00) is the last command, timers are restarted before to load their start value.
+ * Call it in the same critical zone as sending the commands and _set_ExtPack_configuration_restored().
+ *
+ * @param unit The ExtPack unit (without access mode).
+ * @param commands Array with space for EXT_PACK_MAX_RESTORE_COMMANDS commands to store the commands to.
+ * @return The amount of commands (0 if nothing is lost or with EXT_PACK_SHADOW_STATE = 0).
+ */
+uint8_t _get_ExtPack_lost_configuration(unit_t unit, ext_pack_command_t* commands);
+
+/**
+ * @brief Marks the whole sent configuration of a unit as restored.
+ *
+ * @layer Core
+ *
+ * @param unit The ExtPack unit (without access mode).
+ */
+void _set_ExtPack_configuration_restored(unit_t unit);
+
+/**
+ * @brief Sends a block of data "as is" to the same ExtPack unit via UART.
+ *
+ * @layer Core
+ *
+ * @details Only the data fitting into the send buffer is sent. Retry the rest later.
+ *
+ * @param unit The ExtPack unit to which the data should be sent.
+ * @param data The data to be sent.
+ * @param len The amount of data bytes.
+ * @return The amount of sent data bytes (0 if the unit is not in the range of used units).
+ */
+uint8_t _send_block_to_ExtPack(unit_t unit, const uint8_t* data, uint8_t len);
+
+/**
+ * @brief Sends all commands "as is" to ExtPack via UART or none of them (transaction).
+ *
+ * @layer Core
+ *
+ * @details The commands are added to the send buffer at once, so commands sent by custom ISRs can not get in between
+ * (p.ex. between the slave id and the data of an SPI unit). If not all commands fit, nothing is sent.
+ * Check get_ExtPack_tx_free_slots() for the back-pressure of the send buffer.
+ *
+ * @param commands The commands to send.
+ * @param amount The amount of commands (at most get_ExtPack_tx_capacity()).
+ * @return EXT_PACK_SUCCESS if all commands are sent, EXT_PACK_FAILURE if a unit is not in the range of used units
+ * or not enough slots are free in the send buffer.
+ */
+ext_pack_error_t _send_transaction_to_ExtPack(const ext_pack_command_t* commands, uint8_t amount);
+
+/**
+ * @brief Returns the maximum amount of commands of a transaction.
+ *
+ * @layer Core
+ *
+ * @return The size of the send buffer (1 without send buffer).
+ */
+uint8_t get_ExtPack_tx_capacity();
+
 /**
  * @brief Returns the duration a UART send operation to ExtPack needs to perform in the worst case in us.
  *
@@ -101,25 +260,63 @@ ext_pack_error_t _send_to_ExtPack(unit_t unit, uint8_t data);
 uint8_t get_ExtPack_send_duration_us();
 
 /**
- * @brief This function saves the status register and deactivates interrupts.
+ * @brief Returns the amount of command pairs which can be sent at the moment without failing.
  *
  * @layer Core
  *
- * @note This is used to enter a critical zone.
+ * @return The amount of free slots in the send buffer (without send buffer: 1 if the UART is free, 0 otherwise).
+ */
+uint8_t get_ExtPack_tx_free_slots();
+
+/**
+ * @brief Returns if all command pairs are sent completely.
+ *
+ * @layer Core
+ *
+ * @details On the microcontrollers the stop bit of the last byte has to be sent (TX complete flag of the UART),
+ * on the host all command pairs have to be handed over to the serial device.
+ *
+ * @return 1 if all command pairs are sent, 0 otherwise.
  */
-void enter_critical_zone();
+uint8_t is_ExtPack_tx_complete();
 
 /**
- * @brief This function resets the status register to the saved value.
+ * @brief Calls the callback once when all command pairs are sent completely (see is_ExtPack_tx_complete()).
  *
  * @layer Core
  *
- * @details The value was saved when calling enter_critical_zone().
+ * @details The callback is called in the TX complete interrupt or directly if nothing is sent at the moment.
+ * A new call replaces a callback not called yet.
+ *
+ * @param callback The function to call (keep it short like a custom ISR).
+ */
+void notify_ExtPack_tx_complete(void (*callback)());
+
+/**
+ * @brief This function deactivates interrupts and returns the status register before.
+ *
+ * @layer Core
+ *
+ * @details The state is kept by the caller (p.ex. `uint8_t interrupt_state = enter_critical_zone();`),
+ * so critical zones can be nested and used in custom ISRs.
+ *
+ * @note This is used to enter a critical zone.
+ *
+ * @return The interrupt state to pass to exit_critical_zone().
+ */
+uint8_t enter_critical_zone();
+
+/**
+ * @brief This function resets the status register to the given value.
+ *
+ * @layer Core
  *
  * @note This is used to exit a critical zone.
  *
- * @warning Do not use before calling enter_critical_zone()!
+ * @warning Only pass the value returned by the matching enter_critical_zone()!
+ *
+ * @param interrupt_state The interrupt state returned by enter_critical_zone().
  */
-void exit_critical_zone();
+void exit_critical_zone(uint8_t interrupt_state);
 
 #endif //EXTPACK
\ No newline at end of file
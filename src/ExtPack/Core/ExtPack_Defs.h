@@ -33,6 +33,170 @@
     #define USED_UNITS 64 //Default value if no compiler flag is set
 #endif
 
+#ifndef RECV_BUF_LEN
+    /**
+     * @def RECV_BUF_LEN
+     * @brief Defines the amount of received command pairs waiting for their custom ISR (deferred dispatch).
+     *
+     * With 0 the custom ISRs are called directly in the UART receive interrupt.
+     * Otherwise, the receive interrupt only stores the data, sets the event and queues the command pair.
+     * The custom ISRs are called in the main context by dispatch_ExtPack_received().
+     */
+    #define RECV_BUF_LEN 0 //Default value if no compiler flag is set
+#endif
+
+#ifndef EXT_PACK_LINK_STATS
+    /**
+     * @def EXT_PACK_LINK_STATS
+     * @brief Enables (1) or removes (0) the link statistics (see ExtPack_Link_Stats.h).
+     */
+    #define EXT_PACK_LINK_STATS 0 //Default value if no compiler flag is set
+#endif
+
+#ifndef EXT_PACK_PROFILING
+    /**
+     * @def EXT_PACK_PROFILING
+     * @brief Enables (1) or removes (0) the cycle profiling of the ISRs and custom ISRs (see ExtPack_Profiling.h).
+     */
+    #define EXT_PACK_PROFILING 0 //Default value if no compiler flag is set
+#endif
+
+#ifndef EXT_PACK_STATIC_UNITS
+    /**
+     * @def EXT_PACK_STATIC_UNITS
+     * @brief Enables (1) the compile-time unit configuration or disables it (0, units are initialized at runtime).
+     *
+     * With 1 the application provides `ExtPack_Unit_Config.h` defining `EXT_PACK_UNITS(UNIT)` with one
+     * `UNIT(unit, unit_type, custom_ISR)` per used unit. The unit types and custom ISRs are stored in flash
+     * and only the configured units take RAM, independent of their unit numbers.
+     * init_ExtPack_Unit() and set_ExtPack_custom_ISR() are not available in this mode.
+     */
+    #define EXT_PACK_STATIC_UNITS 0 //Default value if no compiler flag is set
+#endif
+
+#ifndef EXT_PACK_EVENT_PRIORITIES
+    /**
+     * @def EXT_PACK_EVENT_PRIORITIES
+     * @brief Defines the amount of priorities of the event handlers (see ExtPack_Event_Loop.h).
+     *
+     * Priority 0 is the highest one.
+     */
+    #define EXT_PACK_EVENT_PRIORITIES 4 //Default value if no compiler flag is set
+#endif
+
+#ifndef EXT_PACK_PACED_JOBS
+    /**
+     * @def EXT_PACK_PACED_JOBS
+     * @brief Defines the amount of paced sends running at the same time (see ExtPack_Paced_Send.h).
+     *
+     * 0 removes the paced sending and leaves its timer unused (opt-in as the timer and its interrupt vector are claimed):
+     * - ATmega328P: Timer2, TIMER2_COMPA_vect
+     * - megaAVR 0-series: TCB1, TCB1_INT_vect
+     * - tinyAVR 1-series: TCD0, TCD0_OVF_vect
+     * - Host: Pacing thread
+     */
+    #define EXT_PACK_PACED_JOBS 0 //Default value if no compiler flag is set
+#endif
+
+#ifndef EXT_PACK_TX_COALESCING
+    /**
+     * @def EXT_PACK_TX_COALESCING
+     * @brief Enables the coalescing of idempotent commands in the send buffer (see _send_coalesced_to_ExtPack()).
+     *
+     * 1: A command replaces the data of the newest queued command if it has the same unit and access mode.
+     * 0: Every command is appended to the send buffer.
+     */
+    #define EXT_PACK_TX_COALESCING 0 //Default value if no compiler flag is set
+#endif
+
+#ifndef EXT_PACK_SHADOW_STATE
+    /**
+     * @def EXT_PACK_SHADOW_STATE
+     * @brief Enables the shadow state of the configuration of the units (see _send_configuration_to_ExtPack()).
+     *
+     * 1: Configuration writes not changing the state of the ExtPack are skipped and restore_ExtPack_configuration() is able to
+     *    send them again after a reset of the ExtPack (6 bytes RAM per unit slot).
+     * 0: Every configuration write is sent.
+     */
+    #define EXT_PACK_SHADOW_STATE 0 //Default value if no compiler flag is set
+#endif
+
+#ifndef EXT_PACK_TIMEBASE
+    /**
+     * @def EXT_PACK_TIMEBASE
+     * @brief Enables the hardware timer backed microsecond clock of the timeouts (see ExtPack_Timebase.h).
+     *
+     * 1: Timeouts are deadlines of the clock and as long as requested. The cycle counter timer of the profiling and its
+     *    overflow interrupt are used: Timer1 and TIMER1_OVF_vect (ATmega328P), TCB0 and TCB0_INT_vect (megaAVR 0-series and
+     *    tinyAVR 1-series), CLOCK_MONOTONIC on the host.
+     * 0: Timeouts count 1 us delays (longer than requested by the overhead of every wait loop pass) and the timer stays unused.
+     */
+    #define EXT_PACK_TIMEBASE 0 //Default value if no compiler flag is set
+#endif
+
+#ifndef EXT_PACK_SLEEP_WAIT
+    /**
+     * @def EXT_PACK_SLEEP_WAIT
+     * @brief Enables the idle sleep of the controller while waiting for events (see wait_for_ExtPack_event()).
+     *
+     * 1: The controller sleeps (SLEEP_MODE_IDLE) between the interrupts until the event is set or the timeout is over.
+     *    Needs EXT_PACK_TIMEBASE = 1, as its overflow interrupt wakes the controller to check the timeout.
+     * 0: The CPU polls the event.
+     */
+    #define EXT_PACK_SLEEP_WAIT 0 //Default value if no compiler flag is set
+#endif
+
+#if EXT_PACK_SLEEP_WAIT && !EXT_PACK_TIMEBASE
+    #error EXT_PACK_SLEEP_WAIT needs EXT_PACK_TIMEBASE!
+#endif
+
+#ifndef EXT_PACK_STANDBY
+    /**
+     * @def EXT_PACK_STANDBY
+     * @brief Enables (1) or removes (0) the standby sleep with wake-up by received frames (see ExtPack_Standby.h).
+     *
+     * Only supported by the megaAVR 0-series and tinyAVR 1-series HALs (start-of-frame detection of the USART).
+     */
+    #define EXT_PACK_STANDBY 0 //Default value if no compiler flag is set
+#endif
+
+#ifndef EXT_PACK_RELIABLE_WINDOW
+    /**
+     * @def EXT_PACK_RELIABLE_WINDOW
+     * @brief Defines the amount of commands queued for the acknowledged sending (see ExtPack_Reliable_Send.h).
+     *
+     * It is the maximum window of commands in flight. 0 removes the reliable sending.
+     * The ACK timeouts of the commands in flight are deadlines of the timebase, so the default is 0 with EXT_PACK_TIMEBASE = 0.
+     */
+    #if EXT_PACK_TIMEBASE
+        #define EXT_PACK_RELIABLE_WINDOW 4 //Default value if no compiler flag is set
+    #else
+        #define EXT_PACK_RELIABLE_WINDOW 0 //Default value if no compiler flag is set
+    #endif
+#endif
+
+#if EXT_PACK_RELIABLE_WINDOW > 0 && !EXT_PACK_TIMEBASE
+    #error EXT_PACK_RELIABLE_WINDOW needs EXT_PACK_TIMEBASE!
+#endif
+
+#ifndef EXT_PACK_ACK_INITIAL_TIMEOUT_US
+    /**
+     * @def EXT_PACK_ACK_INITIAL_TIMEOUT_US
+     * @brief Defines the adaptive ACK timeout in us of a unit type before its first round trip time is measured (see get_ExtPack_ACK_timeout()).
+     */
+    #define EXT_PACK_ACK_INITIAL_TIMEOUT_US 1000 //Default value if no compiler flag is set
+#endif
+
+#ifndef EXT_PACK_ACK_MIN_TIMEOUT_US
+    /**
+     * @def EXT_PACK_ACK_MIN_TIMEOUT_US
+     * @brief Defines the lower limit in us of the adaptive ACK timeouts (see get_ExtPack_ACK_timeout()).
+     *
+     * Keeps a constant round trip time (variance 0) from timing out by the jitter of the clock and the interrupts.
+     */
+    #define EXT_PACK_ACK_MIN_TIMEOUT_US 50 //Default value if no compiler flag is set
+#endif
+
 /**
  * @defgroup ExtPack_Unit_Types ExtPack Unit Type Definitions
  * @brief Definitions of unit types.
@@ -492,4 +656,12 @@ typedef uint8_t unit_t;
 
 /** @} */  // End of ExtPack_Units group
 
+/**
+ * @brief One command pair of a transaction (see _send_transaction_to_ExtPack()).
+ */
+typedef struct {
+    unit_t unit;  /**< The unit number (bit 0-5) and the access mode bits (bit 6-7) */
+    uint8_t data; /**< The data byte */
+} ext_pack_command_t;
+
 #endif //EXTPACK_DEFS_H
\ No newline at end of file
@@ -1,24 +1,98 @@
-#include "ExtPack_Events.h"
+#include "ExtPack_Events_Internal.h"
 #include "ExtPack_Internal.h"
+#include "ExtPack_Timebase.h"
+#include "../HAL/ExtPack_LL.h"
 
-volatile uint64_t unit_events = 0;
+volatile uint8_t unit_events[EXT_PACK_EVENT_BYTES] = {0};
+
+const uint8_t ExtPack_event_masks[8] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+
+/*
+ * Index of the lowest set bit of a nibble (only used for nibbles not being 0).
+ */
+static const uint8_t lowest_bit_of_nibble[16] = {0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0};
 
 void set_ExtPack_event(unit_t unit) {
-    enter_critical_zone();
-    unit_events |= ((uint64_t)1 << unit); // Cast necessary, otherwise treated as a unit_t (uint8_t) --> Max shift: 7
-    exit_critical_zone();
+    if (unit >= USED_UNITS) {
+        return;
+    }
+    uint8_t interrupt_state = enter_critical_zone();
+    unit_events[unit >> 3] |= ExtPack_event_masks[unit & 0x07];
+    exit_critical_zone(interrupt_state);
 }
 
 uint8_t get_ExtPack_event(unit_t unit) {
-    return (unit_events & ((uint64_t)1 << unit)) > 0; // Cast necessary, see reason above
+    if (unit >= USED_UNITS) {
+        return 0;
+    }
+    return (unit_events[unit >> 3] & ExtPack_event_masks[unit & 0x07]) > 0;
 }
 
 void clear_ExtPack_event(unit_t unit) {
-    enter_critical_zone();
-    unit_events &= ~((uint64_t)1 << unit); // Cast necessary, see reason above
-    exit_critical_zone();
+    if (unit >= USED_UNITS) {
+        return;
+    }
+    uint8_t interrupt_state = enter_critical_zone();
+    unit_events[unit >> 3] &= ~ExtPack_event_masks[unit & 0x07];
+    exit_critical_zone(interrupt_state);
+}
+
+ext_pack_error_t wait_for_ExtPack_event(unit_t unit, uint16_t timeout_us) {
+    ext_pack_deadline_t deadline = get_ExtPack_deadline(timeout_us);
+    while (!is_ExtPack_deadline_expired(&deadline)) {
+#if EXT_PACK_SLEEP_WAIT
+        // Check and sleep in one critical zone --> An event set after the check wakes the controller
+        uint8_t interrupt_state = enter_critical_zone();
+        if (get_ExtPack_event(unit)) {
+            exit_critical_zone(interrupt_state);
+            return EXT_PACK_SUCCESS;
+        }
+        sleep_ExtPack_LL_idle(interrupt_state);
+        exit_critical_zone(interrupt_state);
+#else
+        if (get_ExtPack_event(unit)) {
+            return EXT_PACK_SUCCESS;
+        }
+#endif
+    }
+    // Timeout exceeded
+    return EXT_PACK_FAILURE;
+}
+
+/*
+ * Returns the lowest unit of a not empty event byte.
+ */
+static inline unit_t get_lowest_event_unit(uint8_t index, uint8_t events) {
+    uint8_t unit = index << 3;
+    if ((events & 0x0F) == 0) {
+        events >>= 4;
+        unit += 4;
+    }
+    return unit + lowest_bit_of_nibble[events & 0x0F];
+}
+
+unit_t get_next_ExtPack_event() {
+    for (uint8_t index = 0; index < EXT_PACK_EVENT_BYTES; index++) {
+        uint8_t events = unit_events[index];
+        if (events != 0) {
+            return get_lowest_event_unit(index, events);
+        }
+    }
+    return EXT_PACK_NO_EVENT;
+}
+
+unit_t get_next_ExtPack_event_of(const uint8_t* units) {
+    for (uint8_t index = 0; index < EXT_PACK_EVENT_BYTES; index++) {
+        uint8_t events = unit_events[index] & units[index];
+        if (events != 0) {
+            return get_lowest_event_unit(index, events);
+        }
+    }
+    return EXT_PACK_NO_EVENT;
 }
 
 void reset_ExtPack_events() {
-    unit_events = 0;
-}
\ No newline at end of file
+    for (uint8_t index = 0; index < EXT_PACK_EVENT_BYTES; index++) {
+        unit_events[index] = 0;
+    }
+}
@@ -3,10 +3,13 @@
  *
  * @brief Event handling for the UART Extension Pack.
  *
- * This file manages events for all 64 units of ExtPack.
+ * This file manages events for all used units (USED_UNITS) of ExtPack.
+ * Every unit has one event bit which is set when data of the unit is received.
  *
  * ## Features:
  * - Event management interface for ExtPack unit events.
+ * - Finding the lowest unit with a pending event.
+ * - Waiting for the event of a unit (optionally sleeping, see EXT_PACK_SLEEP_WAIT).
  *
  * @author Markus Remy
  * @date 22.06.2025
@@ -17,6 +20,12 @@
 
 #include "ExtPack_Defs.h"
 
+/**
+ * @def EXT_PACK_NO_EVENT
+ * @brief Returned by get_next_ExtPack_event() if no event is pending.
+ */
+#define EXT_PACK_NO_EVENT 0xFF
+
 /**
  * @brief Sets the event for the given ExtPack unit to 1.
  *
@@ -45,6 +54,34 @@ uint8_t get_ExtPack_event(unit_t unit);
  */
 void clear_ExtPack_event(unit_t unit);
 
+/**
+ * @brief Waits until the event of the given unit is set or the timeout is over.
+ *
+ * @layer Core
+ *
+ * @details The event is not cleared. With EXT_PACK_SLEEP_WAIT = 1 the controller sleeps in idle sleep mode between the interrupts,
+ * the RX complete interrupt setting the event wakes it. The timeout is checked on every interrupt, at least on every overflow of
+ * the timebase (every 65536 clock cycles), so a timeout may be up to 65536 clock cycles longer than requested.
+ * Called with disabled interrupts (p.ex. in custom ISRs) the event is polled.
+ *
+ * @param unit The unit to wait for.
+ * @param timeout_us The maximum time to wait in us.
+ * @return EXT_PACK_SUCCESS if the event is set, EXT_PACK_FAILURE if the timeout is over.
+ */
+ext_pack_error_t wait_for_ExtPack_event(unit_t unit, uint16_t timeout_us);
+
+/**
+ * @brief Returns the lowest unit with a pending event.
+ *
+ * @layer Core
+ *
+ * @details The event is not cleared. Drain all events p.ex. with:
+ * `while ((unit = get_next_ExtPack_event()) != EXT_PACK_NO_EVENT) { clear_ExtPack_event(unit); ... }`
+ *
+ * @return The unit or EXT_PACK_NO_EVENT if no event is pending.
+ */
+unit_t get_next_ExtPack_event();
+
 /**
  * @brief Sets the events for all ExtPack units to 0.
  *
@@ -0,0 +1,52 @@
+/**
+ * @file ExtPack_Events_Internal.h
+ *
+ * @brief Access to the event bitmap for the Service layer.
+ *
+ * @layer Core
+ *
+ * @warning This file is only for access for ExtPack library functions. The user should not directly use this header file.
+ *
+ * ## Features:
+ * - Size of the event bitmap.
+ * - Masks of the event bits inside an event byte.
+ * - Finding the lowest unit with a pending event out of a set of units.
+ *
+ * @details The event bitmap stores the event of unit n in bit (n & 7) of byte (n >> 3).
+ * Sets of units (p.ex. all units of one priority) use the same layout.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_EVENTS_INTERNAL_H
+#define EXTPACK_EVENTS_INTERNAL_H
+
+#include "ExtPack_Events.h"
+
+/**
+ * @def EXT_PACK_EVENT_BYTES
+ * @brief Amount of bytes needed to store one event bit per used unit.
+ */
+#define EXT_PACK_EVENT_BYTES ((USED_UNITS + 7) / 8)
+
+/**
+ * @brief Masks of the event bits inside an event byte, the bit of unit n is ExtPack_event_masks[n & 7] (avoids shift loops on AVR).
+ *
+ * @layer Core
+ */
+extern const uint8_t ExtPack_event_masks[8];
+
+/**
+ * @brief Returns the lowest unit of the given set with a pending event.
+ *
+ * @layer Core
+ *
+ * @details The event is not cleared.
+ *
+ * @param units The set of units as bitmap with EXT_PACK_EVENT_BYTES bytes.
+ * @return The unit or EXT_PACK_NO_EVENT if no event of the set is pending.
+ */
+unit_t get_next_ExtPack_event_of(const uint8_t* units);
+
+#endif //EXTPACK_EVENTS_INTERNAL_H
@@ -16,6 +16,7 @@
  * - Declares the `unit` structure and `units` array for unit configurations.
  * - Declares the `unit_data_storage` structure and `unit_data` array for I/O storage.
  * - Provides inline getters for stored input and output values: get_ExtPack_stored_unit_input_values and get_ExtPack_stored_unit_output_values.
+ * - Maps the units to their slots in `unit_data` (sparse with EXT_PACK_STATIC_UNITS = 1).
  *
  * @author Markus Remy
  * @date 17.06.2025
@@ -25,6 +26,16 @@
 #define EXTPACK_INTERNAL_H
 
 #include "ExtPack.h"
+#if EXT_PACK_STATIC_UNITS
+#include "ExtPack_Unit_Config.h"
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#else
+// Host builds have no separate flash address space
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#endif
+#endif
 
 /**
  * @def ACC_MODE0_BIT
@@ -72,6 +83,52 @@ struct unit {
     void (*custom_ISR)(unit_t, uint8_t);
 };
 
+#if EXT_PACK_STATIC_UNITS
+#ifndef EXT_PACK_UNITS
+#error "EXT_PACK_STATIC_UNITS = 1 needs EXT_PACK_UNITS(UNIT) in ExtPack_Unit_Config.h"
+#endif
+
+/*
+ * Generates the slot of every configured unit (ext_pack_slot_unit_UXX).
+ * Slot 0 is used by all not configured units.
+ */
+#define EXT_PACK_UNIT_SLOT_ENUM(unit, unit_type, custom_ISR) ext_pack_slot_##unit,
+enum {
+    EXT_PACK_UNCONFIGURED_UNIT_SLOT = 0,
+    EXT_PACK_UNITS(EXT_PACK_UNIT_SLOT_ENUM)
+    EXT_PACK_CONFIGURED_UNIT_SLOTS
+};
+#undef EXT_PACK_UNIT_SLOT_ENUM
+
+/**
+ * @def EXT_PACK_UNIT_SLOTS
+ * @brief Amount of slots in `unit_data` (and `units`).
+ *
+ * @layer Core
+ *
+ * @details With EXT_PACK_STATIC_UNITS = 1 one slot per configured unit and one slot for all not configured units.
+ * The unit types and custom ISRs are not stored but compiled into process_received_ExtPack_data() as switch.
+ */
+#define EXT_PACK_UNIT_SLOTS EXT_PACK_CONFIGURED_UNIT_SLOTS
+
+/**
+ * @var unit_slots
+ * Flash-resident array with the slot of every unit (0 for not configured units).
+ *
+ * @layer Core
+ */
+extern const uint8_t unit_slots[USED_UNITS] PROGMEM;
+#else
+/**
+ * @def EXT_PACK_UNIT_SLOTS
+ * @brief Amount of slots in `unit_data` (and `units`).
+ *
+ * @layer Core
+ *
+ * @details Without EXT_PACK_STATIC_UNITS every unit has its own slot.
+ */
+#define EXT_PACK_UNIT_SLOTS USED_UNITS
+
 /**
  * @var units
  * Array of unit structures.
@@ -86,6 +143,23 @@ struct unit {
  *       all unit fields are set to zero on startup.
  */
 extern struct unit units[USED_UNITS];
+#endif
+
+/**
+ * @brief Returns the slot of the given unit in `unit_data` (and `units`).
+ *
+ * @layer Core
+ *
+ * @param unit The ExtPack unit (below USED_UNITS).
+ * @return The slot.
+ */
+static inline uint8_t get_ExtPack_unit_slot(unit_t unit) {
+#if EXT_PACK_STATIC_UNITS
+    return pgm_read_byte(&unit_slots[unit]);
+#else
+    return unit;
+#endif
+}
 
 /**
  * @struct unit_data_storage
@@ -120,10 +194,49 @@ struct unit_data_storage {
  *
  * @layer Core
  *
- * @note The array is initialized with zeros, and its size is determined by the `USED_UNITS` constant.
+ * @note The array is initialized with zeros, and its size is determined by the `EXT_PACK_UNIT_SLOTS` constant.
  *       It is used to manage and store the data for all active units which needs it within the system.
+ *       Access it with get_ExtPack_unit_data() as the units are mapped to slots.
  */
-extern struct unit_data_storage unit_data[USED_UNITS];
+extern struct unit_data_storage unit_data[EXT_PACK_UNIT_SLOTS];
+
+/**
+ * @brief Returns the data storage of the given unit of ExtPack.
+ *
+ * @layer Core
+ *
+ * @note With EXT_PACK_STATIC_UNITS = 1 all not configured units share one storage.
+ *
+ * @param unit The ExtPack unit (below USED_UNITS).
+ * @return Pointer to the data storage.
+ */
+static inline struct unit_data_storage* get_ExtPack_unit_data(unit_t unit) {
+    return &unit_data[get_ExtPack_unit_slot(unit)];
+}
+
+/**
+ * @brief Returns the type of the given unit of ExtPack.
+ *
+ * @layer Core
+ *
+ * @note With EXT_PACK_STATIC_UNITS = 1 the type is compiled in as switch over the configured units.
+ *
+ * @param unit The ExtPack unit (below USED_UNITS, without access mode bits).
+ * @return The unit type (EXTPACK_UNDEFINED if not configured).
+ */
+static inline unit_type_t get_ExtPack_unit_type(unit_t unit) {
+#if EXT_PACK_STATIC_UNITS
+#define EXT_PACK_UNIT_TYPE_CASE(unit, unit_type, custom_ISR) case unit: return unit_type;
+    switch (unit) {
+        EXT_PACK_UNITS(EXT_PACK_UNIT_TYPE_CASE)
+        default:
+            return EXTPACK_UNDEFINED;
+    }
+#undef EXT_PACK_UNIT_TYPE_CASE
+#else
+    return units[unit].unit_type;
+#endif
+}
 
 /**
  * @brief Returns the stored output data of the given unit of ExtPack.
@@ -134,8 +247,8 @@ extern struct unit_data_storage unit_data[USED_UNITS];
  * @param unit The ExtPack unit.
  * @return The stored output data.
  */
-inline uint8_t get_ExtPack_stored_unit_output_values(unit_t unit) {
-    return unit_data[unit].output_values;
+static inline uint8_t get_ExtPack_stored_unit_output_values(unit_t unit) {
+    return get_ExtPack_unit_data(unit)->output_values;
 }
 
 /**
@@ -147,8 +260,8 @@ inline uint8_t get_ExtPack_stored_unit_output_values(unit_t unit) {
  * @param unit The ExtPack unit.
  * @return The stored input data.
  */
-inline uint8_t get_ExtPack_stored_unit_input_values(unit_t unit) {
-    return unit_data[unit].input_values;
+static inline uint8_t get_ExtPack_stored_unit_input_values(unit_t unit) {
+    return get_ExtPack_unit_data(unit)->input_values;
 }
 
 /**
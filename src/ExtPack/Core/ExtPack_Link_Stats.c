@@ -0,0 +1,24 @@
+#include "ExtPack_Link_Stats_Internal.h"
+#include "ExtPack.h"
+
+#if EXT_PACK_LINK_STATS
+volatile ext_pack_link_stats_t ExtPack_link_stats = {0};
+#endif
+
+void get_ExtPack_link_stats(ext_pack_link_stats_t* stats) {
+#if EXT_PACK_LINK_STATS
+    uint8_t interrupt_state = enter_critical_zone();
+    *stats = ExtPack_link_stats;
+    exit_critical_zone(interrupt_state);
+#else
+    *stats = (ext_pack_link_stats_t){0};
+#endif
+}
+
+void reset_ExtPack_link_stats() {
+#if EXT_PACK_LINK_STATS
+    uint8_t interrupt_state = enter_critical_zone();
+    ExtPack_link_stats = (ext_pack_link_stats_t){0};
+    exit_critical_zone(interrupt_state);
+#endif
+}
@@ -0,0 +1,97 @@
+/**
+ * @file ExtPack_Link_Stats.h
+ *
+ * @brief Statistics of the UART link to the ExtPack.
+ *
+ * @layer Core
+ *
+ * @details Counts sent and received command pairs as well as all errors and dropped command pairs of the link.
+ * Use them to size SEND_BUF_LEN and RECV_BUF_LEN and to diagnose lost command pairs.
+ * The counters are 32 bit and wrap around after 2^32 - 1 (the sent command pairs after about a day at full link rate),
+ * compare readings by their difference.
+ *
+ * Set the compiler flag `-DEXT_PACK_LINK_STATS=1` to enable the statistics (41 bytes RAM and some cycles in every UART ISR).
+ * Without it the functions only return zeros.
+ *
+ * ## Features:
+ * - Reading the statistics.
+ * - Resetting the statistics.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_LINK_STATS_H
+#define EXTPACK_LINK_STATS_H
+
+#include "ExtPack_Defs.h"
+
+/**
+ * @brief Statistics of the UART link to the ExtPack.
+ *
+ * @layer Core
+ */
+typedef struct {
+    /**
+     * @brief Command pairs accepted for sending.
+     */
+    uint32_t frames_sent;
+    /**
+     * @brief Complete command pairs received without error.
+     */
+    uint32_t frames_received;
+    /**
+     * @brief Received bytes with a framing error (missing stop bit).
+     */
+    uint32_t framing_errors;
+    /**
+     * @brief Received bytes with a parity error.
+     */
+    uint32_t parity_errors;
+    /**
+     * @brief Received bytes with a data overrun (at least one byte before was lost).
+     */
+    uint32_t overrun_errors;
+    /**
+     * @brief Receive state machine resets because the data byte of a command pair did not arrive in time.
+     */
+    uint32_t resyncs;
+    /**
+     * @brief Command pairs rejected because the send buffer (or the UART without send buffer) was full.
+     */
+    uint32_t tx_queue_full;
+    /**
+     * @brief Received command pairs dropped because the unit is invalid, not used or has no unit type.
+     */
+    uint32_t invalid_units;
+    /**
+     * @brief Received command pairs whose custom ISR was dropped because the receive buffer was full (RECV_BUF_LEN > 0).
+     */
+    uint32_t rx_queue_full;
+    /**
+     * @brief Command pairs which replaced the data of the newest queued command pair instead of being appended (EXT_PACK_TX_COALESCING = 1).
+     */
+    uint32_t tx_coalesced;
+    /**
+     * @brief Maximum amount of command pairs waiting in the send buffer at the same time.
+     */
+    uint8_t tx_high_water;
+} ext_pack_link_stats_t;
+
+/**
+ * @brief Copies the current link statistics.
+ *
+ * @layer Core
+ *
+ * @param stats Pointer to the struct to store the statistics in.
+ */
+void get_ExtPack_link_stats(ext_pack_link_stats_t* stats);
+
+/**
+ * @brief Sets all link statistics to 0.
+ *
+ * @layer Core
+ */
+void reset_ExtPack_link_stats();
+
+#endif //EXTPACK_LINK_STATS_H
@@ -0,0 +1,93 @@
+/**
+ * @file ExtPack_Link_Stats_Internal.h
+ *
+ * @brief Counting functions of the link statistics for the HAL and Core.
+ *
+ * @layer Core
+ *
+ * @warning This file is only for access for ExtPack library functions. The user should not directly use this header file.
+ *
+ * ## Features:
+ * - Counting a statistic.
+ * - Counting receive errors.
+ * - Counting sent command pairs and updating the send buffer high-water mark.
+ *
+ * @details All functions are empty with EXT_PACK_LINK_STATS = 0.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_LINK_STATS_INTERNAL_H
+#define EXTPACK_LINK_STATS_INTERNAL_H
+
+#include "ExtPack_Link_Stats.h"
+
+#if EXT_PACK_LINK_STATS
+/**
+ * @brief The link statistics.
+ *
+ * @layer Core
+ */
+extern volatile ext_pack_link_stats_t ExtPack_link_stats;
+
+/**
+ * @def COUNT_EXT_PACK_LINK_STAT
+ * @brief Increments the given counter of the link statistics (p.ex. COUNT_EXT_PACK_LINK_STAT(resyncs)).
+ *
+ * @layer Core
+ *
+ * @note Only call it in ISRs or with the receive interrupt masked.
+ */
+#define COUNT_EXT_PACK_LINK_STAT(counter) (ExtPack_link_stats.counter++)
+#else
+#define COUNT_EXT_PACK_LINK_STAT(counter) ((void)0)
+#endif
+
+/**
+ * @brief Counts the receive errors flagged by the UART for one byte.
+ *
+ * @layer Core
+ *
+ * @param framing_error Not 0 if the byte has a framing error.
+ * @param parity_error Not 0 if the byte has a parity error.
+ * @param overrun_error Not 0 if a byte before was lost.
+ */
+static inline void count_ExtPack_link_receive_errors(uint8_t framing_error, uint8_t parity_error, uint8_t overrun_error) {
+#if EXT_PACK_LINK_STATS
+    if (framing_error) {
+        COUNT_EXT_PACK_LINK_STAT(framing_errors);
+    }
+    if (parity_error) {
+        COUNT_EXT_PACK_LINK_STAT(parity_errors);
+    }
+    if (overrun_error) {
+        COUNT_EXT_PACK_LINK_STAT(overrun_errors);
+    }
+#endif
+}
+
+/**
+ * @brief Counts a command pair passed to the HAL for sending.
+ *
+ * @layer Core
+ *
+ * @note Only call it in ISRs or with the receive interrupt masked.
+ *
+ * @param result EXT_PACK_SUCCESS if the command pair was accepted, EXT_PACK_FAILURE if the send buffer was full.
+ * @param used_slots The amount of command pairs waiting in the send buffer after adding the command pair.
+ */
+static inline void count_ExtPack_link_send(ext_pack_error_t result, uint8_t used_slots) {
+#if EXT_PACK_LINK_STATS
+    if (result == EXT_PACK_SUCCESS) {
+        COUNT_EXT_PACK_LINK_STAT(frames_sent);
+        if (used_slots > ExtPack_link_stats.tx_high_water) {
+            ExtPack_link_stats.tx_high_water = used_slots;
+        }
+    } else {
+        COUNT_EXT_PACK_LINK_STAT(tx_queue_full);
+    }
+#endif
+}
+
+#endif //EXTPACK_LINK_STATS_INTERNAL_H
@@ -0,0 +1,133 @@
+#include "ExtPack_Paced_Send.h"
+#include "ExtPack_Events_Internal.h"
+#include "ExtPack.h"
+#include "../HAL/ExtPack_LL.h"
+
+/*
+ * A running paced send. Unused jobs have len = 0.
+ */
+typedef struct {
+    unit_t unit;
+    const uint8_t* data;    // Next byte to send
+    uint16_t len;           // Bytes left to send
+    uint16_t gap_ticks;
+    uint16_t ticks_left;    // Ticks until the next byte is sent
+} paced_job_t;
+
+#if EXT_PACK_PACED_JOBS > 0
+volatile paced_job_t paced_jobs[EXT_PACK_PACED_JOBS] = {0};
+#endif
+
+/*
+ * Paced send events with the layout of the unit event bitmap.
+ */
+volatile uint8_t paced_send_events[EXT_PACK_EVENT_BYTES] = {0};
+
+#if EXT_PACK_PACED_JOBS > 0
+/*
+ * Returns the job of the unit or NULL.
+ */
+static volatile paced_job_t* find_paced_job(unit_t unit) {
+    for (uint8_t i = 0; i < EXT_PACK_PACED_JOBS; i++) {
+        if (paced_jobs[i].len > 0 && (paced_jobs[i].unit & 0x3F) == unit) {
+            return &paced_jobs[i];
+        }
+    }
+    return 0;
+}
+#endif
+
+ext_pack_error_t start_ExtPack_paced_send(unit_t unit, const uint8_t* buf, uint16_t len, uint16_t gap_us) {
+#if EXT_PACK_PACED_JOBS > 0
+    if ((unit & 0x3F) >= USED_UNITS || len == 0) {
+        return EXT_PACK_FAILURE;
+    }
+    uint16_t gap_ticks = ((uint32_t)gap_us + EXT_PACK_PACE_TICK_US - 1) / EXT_PACK_PACE_TICK_US;
+    uint8_t interrupt_state = enter_critical_zone();
+    if (find_paced_job(unit & 0x3F) != 0) {
+        exit_critical_zone(interrupt_state);
+        return EXT_PACK_FAILURE; // Unit already sending paced
+    }
+    for (uint8_t i = 0; i < EXT_PACK_PACED_JOBS; i++) {
+        if (paced_jobs[i].len == 0) {
+            paced_jobs[i].unit = unit;
+            paced_jobs[i].data = buf;
+            paced_jobs[i].gap_ticks = gap_ticks > 0 ? gap_ticks : 1;
+            paced_jobs[i].ticks_left = 1; // First byte at the next tick
+            paced_jobs[i].len = len;
+            start_ExtPack_LL_pace_timer();
+            exit_critical_zone(interrupt_state);
+            return EXT_PACK_SUCCESS;
+        }
+    }
+    exit_critical_zone(interrupt_state);
+#endif
+    return EXT_PACK_FAILURE; // All jobs busy
+}
+
+void abort_ExtPack_paced_send(unit_t unit) {
+#if EXT_PACK_PACED_JOBS > 0
+    uint8_t interrupt_state = enter_critical_zone();
+    volatile paced_job_t* job = find_paced_job(unit);
+    if (job != 0) {
+        job->len = 0;
+    }
+    exit_critical_zone(interrupt_state);
+#endif
+}
+
+uint8_t is_ExtPack_paced_send_running(unit_t unit) {
+#if EXT_PACK_PACED_JOBS > 0
+    uint8_t interrupt_state = enter_critical_zone();
+    uint8_t running = find_paced_job(unit) != 0;
+    exit_critical_zone(interrupt_state);
+    return running;
+#else
+    return 0;
+#endif
+}
+
+uint8_t get_ExtPack_paced_send_event(unit_t unit) {
+    if (unit >= USED_UNITS) {
+        return 0;
+    }
+    return (paced_send_events[unit >> 3] & ExtPack_event_masks[unit & 0x07]) > 0;
+}
+
+void clear_ExtPack_paced_send_event(unit_t unit) {
+    if (unit >= USED_UNITS) {
+        return;
+    }
+    uint8_t interrupt_state = enter_critical_zone();
+    paced_send_events[unit >> 3] &= ~ExtPack_event_masks[unit & 0x07];
+    exit_critical_zone(interrupt_state);
+}
+
+void process_ExtPack_pace_tick() {
+#if EXT_PACK_PACED_JOBS > 0
+    uint8_t running = 0;
+    for (uint8_t i = 0; i < EXT_PACK_PACED_JOBS; i++) {
+        volatile paced_job_t* job = &paced_jobs[i];
+        if (job->len == 0) {
+            continue;
+        }
+        if (--job->ticks_left == 0) {
+            if (_send_to_ExtPack(job->unit, *job->data) == EXT_PACK_SUCCESS) {
+                job->data++;
+                job->ticks_left = job->gap_ticks;
+                if (--job->len == 0) {
+                    unit_t unit = job->unit & 0x3F;
+                    paced_send_events[unit >> 3] |= ExtPack_event_masks[unit & 0x07];
+                    continue;
+                }
+            } else {
+                job->ticks_left = 1; // Send buffer full, retry at the next tick
+            }
+        }
+        running = 1;
+    }
+    if (!running) {
+        stop_ExtPack_LL_pace_timer();
+    }
+#endif
+}
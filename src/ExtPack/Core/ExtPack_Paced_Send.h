@@ -0,0 +1,105 @@
+/**
+ * @file ExtPack_Paced_Send.h
+ *
+ * @brief Non-blocking paced sending of buffers to slow ExtPack units.
+ *
+ * @layer Core
+ *
+ * @details A paced send adds one byte of the buffer to the send buffer per gap, so slow partners behind the
+ * ExtPack (p.ex. a UART with a low baud rate) are not overrun. The bytes are fed by a timer ISR of the HAL
+ * ticking every EXT_PACK_PACE_TICK_US while paced sends are running, the CPU is not blocked in between:
+ * - ATmega328P: Timer2
+ * - megaAVR 0-series: TCB1
+ * - tinyAVR 1-series: TCD0
+ * - Host: Pacing thread
+ *
+ * The gaps are rounded up to EXT_PACK_PACE_TICK_US. If the send buffer is full, the byte is retried at the next tick.
+ * When all bytes are in the send buffer the paced send event of the unit is set.
+ *
+ * Set the compiler flag `-DEXT_PACK_PACED_JOBS=<Amount>` for the amount of paced sends running at the same time.
+ * The default 0 removes the paced sending and leaves the timer and its interrupt vector unused.
+ *
+ * ## Features:
+ * - Starting and aborting a paced send.
+ * - Calculating the gap from the baud rate of the partner.
+ * - Paced send (completion) events.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_PACED_SEND_H
+#define EXTPACK_PACED_SEND_H
+
+#include "ExtPack_Defs.h"
+
+/**
+ * @brief Starts sending len bytes of the buffer to the unit with the given gap between the bytes.
+ *
+ * @layer Core
+ *
+ * @warning The buffer is not copied. It has to stay valid until the paced send event of the unit is set.
+ *
+ * @param unit The ExtPack unit to which the data should be sent. Including the correct set access mode for sending.
+ * @param buf The data to be sent (may contain '\0').
+ * @param len The amount of bytes to send.
+ * @param gap_us The time between two bytes in us (rounded up to EXT_PACK_PACE_TICK_US).
+ * @return EXT_PACK_SUCCESS if started, EXT_PACK_FAILURE if the unit is not used, already sending paced or all jobs are busy.
+ */
+ext_pack_error_t start_ExtPack_paced_send(unit_t unit, const uint8_t* buf, uint16_t len, uint16_t gap_us);
+
+/**
+ * @brief Aborts the paced send of the unit. The paced send event is not set.
+ *
+ * @layer Core
+ *
+ * @param unit The ExtPack unit (without access mode bits).
+ */
+void abort_ExtPack_paced_send(unit_t unit);
+
+/**
+ * @brief Returns if a paced send of the unit is running.
+ *
+ * @layer Core
+ *
+ * @param unit The ExtPack unit (without access mode bits).
+ * @return 1 if running, 0 otherwise.
+ */
+uint8_t is_ExtPack_paced_send_running(unit_t unit);
+
+/**
+ * @brief Returns the paced send event of the unit (set when all bytes of the paced send are in the send buffer).
+ *
+ * @layer Core
+ *
+ * @param unit The ExtPack unit (without access mode bits).
+ * @return 1 if set, 0 otherwise.
+ */
+uint8_t get_ExtPack_paced_send_event(unit_t unit);
+
+/**
+ * @brief Clears the paced send event of the unit.
+ *
+ * @layer Core
+ *
+ * @param unit The ExtPack unit (without access mode bits).
+ */
+void clear_ExtPack_paced_send_event(unit_t unit);
+
+/**
+ * @brief Returns the gap between two bytes for a partner with the given baud rate (8N1, 10 bits per byte).
+ *
+ * @layer Core
+ *
+ * @param baud_rate The baud rate of the partner (p.ex. the UART of a UART unit).
+ * @return The gap in us (rounded up), clamped to UINT16_MAX for baud rates below 153.
+ */
+static inline uint16_t get_ExtPack_pace_gap_us(uint32_t baud_rate) {
+    if (baud_rate == 0) {
+        return UINT16_MAX;
+    }
+    uint32_t gap_us = (10UL * 1000000UL + baud_rate - 1) / baud_rate;
+    return gap_us > UINT16_MAX ? UINT16_MAX : (uint16_t)gap_us;
+}
+
+#endif //EXTPACK_PACED_SEND_H
@@ -0,0 +1,40 @@
+#include "ExtPack_Profiling_Internal.h"
+#include "ExtPack.h"
+
+#if EXT_PACK_PROFILING
+volatile ext_pack_profile_t ExtPack_profiles[EXT_PACK_PROFILE_HANDLERS] = {0};
+volatile ext_pack_profile_t ExtPack_unit_profiles[USED_UNITS] = {0};
+#endif
+
+void get_ExtPack_profile(ext_pack_profile_handler_t handler, ext_pack_profile_t* profile) {
+#if EXT_PACK_PROFILING
+    uint8_t interrupt_state = enter_critical_zone();
+    *profile = ExtPack_profiles[handler];
+    exit_critical_zone(interrupt_state);
+#else
+    *profile = (ext_pack_profile_t){0};
+#endif
+}
+
+void get_ExtPack_unit_profile(unit_t unit, ext_pack_profile_t* profile) {
+#if EXT_PACK_PROFILING
+    uint8_t interrupt_state = enter_critical_zone();
+    *profile = ExtPack_unit_profiles[unit];
+    exit_critical_zone(interrupt_state);
+#else
+    *profile = (ext_pack_profile_t){0};
+#endif
+}
+
+void reset_ExtPack_profiles() {
+#if EXT_PACK_PROFILING
+    uint8_t interrupt_state = enter_critical_zone();
+    for (uint8_t handler = 0; handler < EXT_PACK_PROFILE_HANDLERS; handler++) {
+        ExtPack_profiles[handler] = (ext_pack_profile_t){0};
+    }
+    for (uint8_t unit = 0; unit < USED_UNITS; unit++) {
+        ExtPack_unit_profiles[unit] = (ext_pack_profile_t){0};
+    }
+    exit_critical_zone(interrupt_state);
+#endif
+}
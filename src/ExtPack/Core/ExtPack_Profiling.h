@@ -0,0 +1,99 @@
+/**
+ * @file ExtPack_Profiling.h
+ *
+ * @brief Cycle profiling of the ExtPack ISRs and the custom ISRs.
+ *
+ * @layer Core
+ *
+ * @details With the compiler flag `-DEXT_PACK_PROFILING=1` the library measures the clock cycles of
+ * - the UART receive ISR (including the custom ISRs called in it),
+ * - the UART data register empty ISR,
+ * - the resync timer ISR of the receive state machine and
+ * - every custom ISR call per unit (in the receive ISR or in dispatch_ExtPack_received()).
+ *
+ * The HAL uses a free running 16 bit hardware timer without prescaler (see ExtPack_LL.h).
+ * Measurements start at the first and end at the last statement of a handler.
+ * The ISR prologue and epilogue (saving and restoring of the registers) are not included.
+ * Handlers running 65536 clock cycles or longer (p.ex. about 4 ms at 16 MHz) are not measured correctly.
+ *
+ * At 1 MBaud a byte is received every 10 us, so the receive ISR has to stay below 10 us * F_CPU clock cycles.
+ *
+ * ## Features:
+ * - Reading min, max and mean clock cycles per handler.
+ * - Reading min, max and mean clock cycles per custom ISR of a unit.
+ * - Resetting all profiles.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_PROFILING_H
+#define EXTPACK_PROFILING_H
+
+#include "ExtPack_Defs.h"
+
+/**
+ * @brief The profiled handlers of the library.
+ *
+ * @layer Core
+ */
+typedef enum {
+    EXT_PACK_PROFILE_RX_ISR,        /**< UART receive ISR (including direct custom ISR calls) */
+    EXT_PACK_PROFILE_DRE_ISR,       /**< UART data register empty ISR */
+    EXT_PACK_PROFILE_RESYNC_ISR,    /**< Resync timer ISR of the receive state machine */
+    EXT_PACK_PROFILE_PACE_ISR,      /**< Pace timer ISR of the paced sends */
+    EXT_PACK_PROFILE_HANDLERS       /**< Amount of profiled handlers */
+} ext_pack_profile_handler_t;
+
+/**
+ * @brief Measured clock cycles of a handler.
+ *
+ * @layer Core
+ */
+typedef struct {
+    uint16_t min;   /**< Minimum clock cycles */
+    uint16_t max;   /**< Maximum clock cycles */
+    uint32_t sum;   /**< Sum of the clock cycles of all calls */
+    uint16_t count; /**< Amount of calls (profile stops counting at 65535 calls) */
+} ext_pack_profile_t;
+
+/**
+ * @brief Copies the profile of the given handler.
+ *
+ * @layer Core
+ *
+ * @param handler The handler to get the profile of.
+ * @param profile Pointer to the struct to store the profile in.
+ */
+void get_ExtPack_profile(ext_pack_profile_handler_t handler, ext_pack_profile_t* profile);
+
+/**
+ * @brief Copies the profile of the custom ISR of the given unit.
+ *
+ * @layer Core
+ *
+ * @param unit The unit to get the custom ISR profile of.
+ * @param profile Pointer to the struct to store the profile in.
+ */
+void get_ExtPack_unit_profile(unit_t unit, ext_pack_profile_t* profile);
+
+/**
+ * @brief Sets all profiles to 0.
+ *
+ * @layer Core
+ */
+void reset_ExtPack_profiles();
+
+/**
+ * @brief Returns the mean clock cycles of a profile.
+ *
+ * @layer Core
+ *
+ * @param profile The profile.
+ * @return The mean clock cycles or 0 if the handler was not called.
+ */
+inline uint16_t get_ExtPack_profile_mean(const ext_pack_profile_t* profile) {
+    return profile->count > 0 ? (uint16_t)(profile->sum / profile->count) : 0;
+}
+
+#endif //EXTPACK_PROFILING_H
@@ -0,0 +1,94 @@
+/**
+ * @file ExtPack_Profiling_Internal.h
+ *
+ * @brief Measurement macros of the cycle profiling for the HAL and Core.
+ *
+ * @layer Core
+ *
+ * @warning This file is only for access for ExtPack library functions. The user should not directly use this header file.
+ *
+ * ## Features:
+ * - Starting a measurement.
+ * - Ending a measurement of a handler or a custom ISR.
+ *
+ * @details All macros are empty with EXT_PACK_PROFILING = 0.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_PROFILING_INTERNAL_H
+#define EXTPACK_PROFILING_INTERNAL_H
+
+#include "ExtPack_Profiling.h"
+#include "../HAL/ExtPack_LL.h"
+
+#if EXT_PACK_PROFILING
+/**
+ * @brief Profiles of the handlers.
+ *
+ * @layer Core
+ */
+extern volatile ext_pack_profile_t ExtPack_profiles[EXT_PACK_PROFILE_HANDLERS];
+
+/**
+ * @brief Profiles of the custom ISRs of all units.
+ *
+ * @layer Core
+ */
+extern volatile ext_pack_profile_t ExtPack_unit_profiles[USED_UNITS];
+
+/**
+ * @brief Adds a measurement to a profile.
+ *
+ * @layer Core
+ *
+ * @param profile The profile to update.
+ * @param cycles The measured clock cycles.
+ */
+static inline void add_ExtPack_profile_measurement(volatile ext_pack_profile_t* profile, uint16_t cycles) {
+    if (profile->count == UINT16_MAX) {
+        return; // Full --> Mean would be wrong
+    }
+    if (profile->count == 0 || cycles < profile->min) {
+        profile->min = cycles;
+    }
+    if (cycles > profile->max) {
+        profile->max = cycles;
+    }
+    profile->sum += cycles;
+    profile->count++;
+}
+
+/**
+ * @def EXT_PACK_PROFILE_START
+ * @brief Starts a measurement by saving the current clock cycle counter in a new variable with the given name.
+ *
+ * @layer Core
+ */
+#define EXT_PACK_PROFILE_START(start_var) uint16_t start_var = get_ExtPack_LL_cycles()
+
+/**
+ * @def EXT_PACK_PROFILE_END
+ * @brief Ends the measurement started with EXT_PACK_PROFILE_START and adds it to the profile of the handler.
+ *
+ * @layer Core
+ */
+#define EXT_PACK_PROFILE_END(handler, start_var) \
+    add_ExtPack_profile_measurement(&ExtPack_profiles[handler], get_ExtPack_LL_cycles() - (start_var))
+
+/**
+ * @def EXT_PACK_PROFILE_UNIT_END
+ * @brief Ends the measurement started with EXT_PACK_PROFILE_START and adds it to the custom ISR profile of the unit.
+ *
+ * @layer Core
+ */
+#define EXT_PACK_PROFILE_UNIT_END(unit, start_var) \
+    add_ExtPack_profile_measurement(&ExtPack_unit_profiles[unit], get_ExtPack_LL_cycles() - (start_var))
+#else
+#define EXT_PACK_PROFILE_START(start_var)
+#define EXT_PACK_PROFILE_END(handler, start_var)
+#define EXT_PACK_PROFILE_UNIT_END(unit, start_var)
+#endif
+
+#endif //EXTPACK_PROFILING_INTERNAL_H
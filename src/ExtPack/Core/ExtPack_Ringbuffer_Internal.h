@@ -13,6 +13,15 @@
  * - Read ringbuffer
  * - Write ringbuffer
  *
+ * @details The ringbuffers are generated at compile time with DEFINE_RINGBUFFER() for a constant capacity and element type.
+ * Therefore, no division is needed to wrap the indices:
+ * - Capacities being a power of two use free running indices which are masked.
+ * - All other capacities use one additional slot which always stays empty and wrap the indices with a compare.
+ *
+ * The ringbuffer is lock-free for one producer and one consumer (p.ex. main context and data register empty ISR).
+ * The write index is only written by the producer, the read index only by the consumer.
+ * Multiple producers (or consumers) have to exclude each other.
+ *
  * @author Markus Remy
  * @date 22.06.2025
  */
@@ -23,129 +32,135 @@
 #include "ExtPack.h"
 
 /**
- * @brief Typedef for the ringbuffer memory pointer.
- *
- * @layer Core
- *
- * Represents a pointer to the memory area (buffer) used for storing ringbuffer elements.
- * This buffer is externally provided and managed by the ringbuffer metadata.
- */
-typedef volatile uint16_t* ringbuffer_t;
-
-/**
- * @brief Type of individual elements stored in the ringbuffer.
- *
- * @layer Core
- *
- * Each slot in the ringbuffer holds a value of type `uint16_t`.
- */
-typedef uint16_t ringbuffer_elem_t;
-
-/**
- * @brief Metadata structure for managing the ringbuffer state.
+ * @def RINGBUFFER_MEMORY_BARRIER
+ * @brief Orders the accesses to the buffer data and the indices between producer and consumer.
  *
  * @layer Core
  *
- * @details Contains buffer length, available slot count, and indices for reading and writing.
- * Required to control the behavior of the ringbuffer.
+ * @details On AVR a compiler barrier is sufficient. Hosts (p.ex. the host HAL) need a hardware memory barrier.
  */
-typedef struct {
-    /**
-     * @brief Pointer to the ringbuffer memory array.
-     *
-     * @layer Core
-     *
-     * This points to the memory block that stores the actual ringbuffer data elements.
-     */
-    ringbuffer_t data;
-    /**
-     * @brief Total number of slots in the ringbuffer.
-     *
-     * @layer Core
-     *
-     * This defines the maximum capacity of the ringbuffer.
-     */
-    uint8_t buf_len;
-    /**
-     * @brief Number of currently free slots in the buffer.
-     *
-     * @layer Core
-     *
-     * @details Decreases with every write and increases with every read operation.
-     */
-    uint8_t free_slots;
-    /**
-     * @brief Index of the next slot to read from.
-     *
-     * @layer Core
-     */
-    uint8_t next_read_slot_index;
-    /**
-     * @brief Index of the next slot to write to.
-     *
-     * @layer Core
-     */
-    uint8_t next_write_slot_index;
-} ringbuffer_metadata_t;
+#if defined(__AVR__)
+    #define RINGBUFFER_MEMORY_BARRIER() __asm__ __volatile__("" ::: "memory")
+#else
+    #define RINGBUFFER_MEMORY_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
 
 /**
- * @brief Initializes the metadata of the ringbuffer given as pointer.
+ * @def RINGBUFFER_IS_POW2
+ * @brief Checks if the capacity of a ringbuffer is a power of two (--> indices are masked).
  *
  * @layer Core
- *
- * @note Create a ringbuffer with wished length first (ringbuffer_elem_t buf[buf_len];)
- * as well as the metadata struct (ringbuffer_metadata_t xyz;) and pass both as well as the chosen buffer length here.
- *
- * @param buf A pointer to the ringbuffer to connect to the metadata.
- * @param buf_len The length of the ringbuffer to connect.
- * @param metadata A pointer to the metadata to initialize.
- */
-void init_ringbuffer_metadata(ringbuffer_t buf, uint8_t buf_len, volatile ringbuffer_metadata_t* metadata);
-
-/**
- * @brief Writes an element in the buffer when enough slots are free.
- *
- * @layer Core
- *
- * @param metadata The metadata of the ringbuffer to work with.
- * @param data The data to write.
- * @return EXT_PACK_SUCCESS if successful, EXT_PACK_FAILURE if no spot to write available.
- */
-ext_pack_error_t write_buf(volatile ringbuffer_metadata_t* metadata, ringbuffer_elem_t data);
-
-/**
- * @brief Read an element of the buffer when something to read is available.
- *
- * @layer Core
- *
- * @param metadata The metadata of the ringbuffer to read from.
- * @param data A pointer to the data slot to store the result if read is successful.
- * @return EXT_PACK_SUCCESS if successful, EXT_PACK_FAILURE if nothing to read available.
  */
-ext_pack_error_t read_buf(volatile ringbuffer_metadata_t* metadata, ringbuffer_elem_t* data);
+#define RINGBUFFER_IS_POW2(capacity) (((capacity) & ((capacity) - 1)) == 0)
 
 /**
- * @brief Checks if the given buffer is full.
+ * @def RINGBUFFER_SLOTS
+ * @brief Amount of slots needed for a ringbuffer with the given capacity.
  *
  * @layer Core
  *
- * @param metadata The buffer metadata to check.
- * @return 1 if full, 0 otherwise.
+ * @details Capacities not being a power of two need one slot more to distinguish a full from an empty buffer.
  */
-static inline uint8_t is_buf_full(volatile ringbuffer_metadata_t* metadata) {
-    return metadata->free_slots == 0;
-}
+#define RINGBUFFER_SLOTS(capacity) (RINGBUFFER_IS_POW2(capacity) ? (capacity) : (capacity) + 1)
 
 /**
- * @brief Checks if the given buffer is empty.
+ * @def DEFINE_RINGBUFFER
+ * @brief Generates a ringbuffer type with a constant capacity and its access functions.
  *
  * @layer Core
  *
- * @param metadata The buffer metadata to check.
- * @return 1 if empty, 0 otherwise.
+ * @details Generates:
+ * - `name_t`: The ringbuffer type (create an instance with `volatile name_t xyz;`).
+ * - `void init_name(volatile name_t* buf)`: Empties the ringbuffer.
+ * - `ext_pack_error_t write_name(volatile name_t* buf, elem_type data)`: Writes an element when a slot is free (producer only).
+ *    Returns EXT_PACK_SUCCESS if successful, EXT_PACK_FAILURE if no spot to write available.
+ * - `ext_pack_error_t read_name(volatile name_t* buf, elem_type* data)`: Reads an element when one is available (consumer only).
+ *    Returns EXT_PACK_SUCCESS if successful, EXT_PACK_FAILURE if nothing to read available.
+ * - `uint8_t get_name_used_slots(volatile name_t* buf)`: Returns the amount of stored elements.
+ * - `uint8_t is_name_empty(volatile name_t* buf)` and `uint8_t is_name_full(volatile name_t* buf)`: Return 1 if true, 0 otherwise.
+ * - `volatile elem_type* peek_name(volatile name_t* buf, uint8_t age)`: Returns the stored element written age writes before the newest one
+ *    (0: newest, has to be below the used slots). Only modify it while the consumer can not run (p.ex. its interrupt is masked).
+ *
+ * @note The capacity has to be a constant between 1 and 254.
+ *
+ * @param name The name of the ringbuffer type.
+ * @param elem_type The type of the stored elements.
+ * @param capacity The maximum amount of stored elements.
  */
-static inline uint8_t is_buf_empty(volatile ringbuffer_metadata_t* metadata) {
-    return metadata->free_slots == metadata->buf_len;
-}
+#define DEFINE_RINGBUFFER(name, elem_type, capacity) \
+    _Static_assert((capacity) >= 1 && (capacity) <= 254, "Capacity of ringbuffer " #name " has to be between 1 and 254!"); \
+    \
+    typedef struct { \
+        elem_type data[RINGBUFFER_SLOTS(capacity)]; \
+        uint8_t next_read_slot_index;  /* Only written by the consumer */ \
+        uint8_t next_write_slot_index; /* Only written by the producer */ \
+    } name##_t; \
+    \
+    static inline void init_##name(volatile name##_t* buf) { \
+        buf->next_read_slot_index = 0; \
+        buf->next_write_slot_index = 0; \
+    } \
+    \
+    static inline uint8_t name##_next_index(uint8_t index) { \
+        if (RINGBUFFER_IS_POW2(capacity)) { \
+            return index + 1; /* Free running, overflows at 256 which is a multiple of the capacity */ \
+        } \
+        return index == (capacity) ? 0 : index + 1; \
+    } \
+    \
+    static inline uint8_t name##_slot(uint8_t index) { \
+        return RINGBUFFER_IS_POW2(capacity) ? (index & ((capacity) - 1)) : index; \
+    } \
+    \
+    static inline uint8_t get_##name##_used_slots(volatile name##_t* buf) { \
+        uint8_t write_index = buf->next_write_slot_index; \
+        uint8_t read_index = buf->next_read_slot_index; \
+        if (RINGBUFFER_IS_POW2(capacity)) { \
+            return (uint8_t)(write_index - read_index); \
+        } \
+        return write_index >= read_index ? write_index - read_index : write_index + ((capacity) + 1) - read_index; \
+    } \
+    \
+    static inline uint8_t is_##name##_empty(volatile name##_t* buf) { \
+        return buf->next_write_slot_index == buf->next_read_slot_index; \
+    } \
+    \
+    static inline uint8_t is_##name##_full(volatile name##_t* buf) { \
+        if (RINGBUFFER_IS_POW2(capacity)) { \
+            return (uint8_t)(buf->next_write_slot_index - buf->next_read_slot_index) == (capacity); \
+        } \
+        return name##_next_index(buf->next_write_slot_index) == buf->next_read_slot_index; \
+    } \
+    \
+    static inline volatile elem_type* peek_##name(volatile name##_t* buf, uint8_t age) { \
+        uint8_t write_index = buf->next_write_slot_index; \
+        if (RINGBUFFER_IS_POW2(capacity)) { \
+            return &buf->data[name##_slot((uint8_t)(write_index - 1 - age))]; \
+        } \
+        return &buf->data[write_index > age ? write_index - 1 - age : write_index + (capacity) - age]; \
+    } \
+    \
+    static inline ext_pack_error_t write_##name(volatile name##_t* buf, elem_type data) { \
+        uint8_t current_write_index = buf->next_write_slot_index; \
+        if (is_##name##_full(buf)) { \
+            return EXT_PACK_FAILURE; /* Error, buffer full */ \
+        } \
+        buf->data[name##_slot(current_write_index)] = data; \
+        RINGBUFFER_MEMORY_BARRIER(); /* Data has to be written before it is published to the consumer */ \
+        buf->next_write_slot_index = name##_next_index(current_write_index); \
+        return EXT_PACK_SUCCESS; \
+    } \
+    \
+    static inline ext_pack_error_t read_##name(volatile name##_t* buf, elem_type* data) { \
+        uint8_t current_read_index = buf->next_read_slot_index; \
+        if (current_read_index == buf->next_write_slot_index) { \
+            return EXT_PACK_FAILURE; /* Error, nothing to read */ \
+        } \
+        RINGBUFFER_MEMORY_BARRIER(); /* Data must not be read before the write index */ \
+        *data = buf->data[name##_slot(current_read_index)]; \
+        RINGBUFFER_MEMORY_BARRIER(); /* Data has to be read before the slot is released to the producer */ \
+        buf->next_read_slot_index = name##_next_index(current_read_index); \
+        return EXT_PACK_SUCCESS; \
+    }
 
 #endif //EXTPACK_RINGBUFFER_INTERNAL_H
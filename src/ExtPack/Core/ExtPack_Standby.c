@@ -0,0 +1,33 @@
+#include "ExtPack_Standby_Internal.h"
+#include "ExtPack.h"
+#include "../HAL/ExtPack_LL.h"
+
+#if EXT_PACK_STANDBY
+volatile ext_pack_standby_stats_t ExtPack_standby_stats = {0};
+#endif
+
+ext_pack_error_t enter_ExtPack_standby() {
+#if EXT_PACK_STANDBY
+    return sleep_ExtPack_LL_standby();
+#else
+    return EXT_PACK_FAILURE;
+#endif
+}
+
+void get_ExtPack_standby_stats(ext_pack_standby_stats_t* stats) {
+#if EXT_PACK_STANDBY
+    uint8_t interrupt_state = enter_critical_zone();
+    *stats = ExtPack_standby_stats;
+    exit_critical_zone(interrupt_state);
+#else
+    *stats = (ext_pack_standby_stats_t){0};
+#endif
+}
+
+void reset_ExtPack_standby_stats() {
+#if EXT_PACK_STANDBY
+    uint8_t interrupt_state = enter_critical_zone();
+    ExtPack_standby_stats = (ext_pack_standby_stats_t){0};
+    exit_critical_zone(interrupt_state);
+#endif
+}
@@ -0,0 +1,79 @@
+/**
+ * @file ExtPack_Standby.h
+ *
+ * @brief Standby sleep between the ExtPack traffic with wake-up by the start of a received frame.
+ *
+ * @layer Core
+ *
+ * @details With the compiler flag `-DEXT_PACK_STANDBY=1` the megaAVR 0-series and tinyAVR 1-series HALs put the controller
+ * into standby sleep mode. The start-of-frame detection of the USART wakes it on the falling edge of the start bit,
+ * the byte is received as soon as the oscillator runs again. Whether the first byte is sampled correctly
+ * depends on the start-up time of the oscillator compared to the bit time (1 us at 1 MBaud), check the wake errors.
+ * The timers (timebase, resync and pace timer) stop in standby, the time spent in standby is not counted by the timebase.
+ *
+ * The wake latency is the time from the start bit to the first instruction of the receive start interrupt.
+ * It is the time of a frame (9.5 bit times until the stop bit is sampled) minus the clock cycles from the receive start
+ * to the receive complete interrupt, measured with the cycle counter (EXT_PACK_TIMEBASE = 1 or EXT_PACK_PROFILING = 1).
+ *
+ * The ATmega328P and the host do not support it, enter_ExtPack_standby() always fails there.
+ *
+ * ## Features:
+ * - Entering standby until the next interrupt.
+ * - Reading and resetting the wake-up statistics.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_STANDBY_H
+#define EXTPACK_STANDBY_H
+
+#include "ExtPack_Defs.h"
+
+/**
+ * @brief Statistics of the standby sleeps.
+ *
+ * @layer Core
+ */
+typedef struct {
+    uint16_t standby_entries;   /**< Times the controller went to standby */
+    uint16_t wakeups;           /**< Wake-ups by the start of a received frame */
+    uint16_t wake_errors;       /**< Wake-up bytes received with a framing, parity or overrun error */
+    uint16_t min_wake_cycles;   /**< Minimum wake latency in clock cycles */
+    uint16_t max_wake_cycles;   /**< Maximum wake latency in clock cycles */
+    uint32_t sum_wake_cycles;   /**< Sum of the wake latencies of all wake-ups (mean = sum / wakeups) */
+} ext_pack_standby_stats_t;
+
+/**
+ * @brief Puts the controller into standby sleep mode until the next interrupt (p.ex. the start of a received frame).
+ *
+ * @layer Core
+ *
+ * @details Only sleeps between the ExtPack traffic: Nothing is left to send, no paced send is running
+ * and no command pair is received halfway. Call it in the main loop when nothing else is to do,
+ * events set by the wake-up byte are pending when it returns.
+ *
+ * @note Call it with enabled interrupts only (not in custom ISRs).
+ *
+ * @return EXT_PACK_SUCCESS after the controller slept, EXT_PACK_FAILURE if it did not sleep
+ * (ExtPack traffic, interrupts disabled, EXT_PACK_STANDBY = 0 or not supported by the HAL).
+ */
+ext_pack_error_t enter_ExtPack_standby();
+
+/**
+ * @brief Copies the current standby statistics.
+ *
+ * @layer Core
+ *
+ * @param stats Pointer to the struct to store the statistics in.
+ */
+void get_ExtPack_standby_stats(ext_pack_standby_stats_t* stats);
+
+/**
+ * @brief Sets all standby statistics to 0.
+ *
+ * @layer Core
+ */
+void reset_ExtPack_standby_stats();
+
+#endif //EXTPACK_STANDBY_H
@@ -0,0 +1,73 @@
+/**
+ * @file ExtPack_Standby_Internal.h
+ *
+ * @brief Counting functions of the standby statistics for the HAL.
+ *
+ * @layer Core
+ *
+ * @warning This file is only for access for ExtPack library functions. The user should not directly use this header file.
+ *
+ * ## Features:
+ * - Counting a standby entry.
+ * - Counting a wake-up with its latency.
+ *
+ * @details All functions are empty with EXT_PACK_STANDBY = 0.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_STANDBY_INTERNAL_H
+#define EXTPACK_STANDBY_INTERNAL_H
+
+#include "ExtPack_Standby.h"
+
+#if EXT_PACK_STANDBY
+/**
+ * @brief The standby statistics.
+ *
+ * @layer Core
+ */
+extern volatile ext_pack_standby_stats_t ExtPack_standby_stats;
+#endif
+
+/**
+ * @brief Counts an entry of the standby sleep mode.
+ *
+ * @layer Core
+ *
+ * @note Only call it in a critical zone.
+ */
+static inline void count_ExtPack_standby_entry() {
+#if EXT_PACK_STANDBY
+    ExtPack_standby_stats.standby_entries++;
+#endif
+}
+
+/**
+ * @brief Counts a wake-up by the start of a received frame.
+ *
+ * @layer Core
+ *
+ * @note Only call it in ISRs.
+ *
+ * @param receive_error Not 0 if the wake-up byte was received with an error.
+ * @param wake_cycles The wake latency in clock cycles.
+ */
+static inline void count_ExtPack_wakeup(uint8_t receive_error, uint16_t wake_cycles) {
+#if EXT_PACK_STANDBY
+    if (ExtPack_standby_stats.wakeups == 0 || wake_cycles < ExtPack_standby_stats.min_wake_cycles) {
+        ExtPack_standby_stats.min_wake_cycles = wake_cycles;
+    }
+    if (wake_cycles > ExtPack_standby_stats.max_wake_cycles) {
+        ExtPack_standby_stats.max_wake_cycles = wake_cycles;
+    }
+    ExtPack_standby_stats.sum_wake_cycles += wake_cycles;
+    ExtPack_standby_stats.wakeups++;
+    if (receive_error) {
+        ExtPack_standby_stats.wake_errors++;
+    }
+#endif
+}
+
+#endif //EXTPACK_STANDBY_INTERNAL_H
@@ -0,0 +1,45 @@
+#include "ExtPack_Timebase_Internal.h"
+#include "../HAL/ExtPack_LL.h"
+#include <util/delay.h>
+
+#if EXT_PACK_TIMEBASE
+volatile uint8_t ExtPack_timebase_running = 0;
+#endif
+
+uint8_t is_ExtPack_timebase_running() {
+#if EXT_PACK_TIMEBASE
+    return ExtPack_timebase_running;
+#else
+    return 0;
+#endif
+}
+
+uint32_t get_ExtPack_now_us() {
+#if EXT_PACK_TIMEBASE
+    return get_ExtPack_LL_time_us();
+#else
+    return 0;
+#endif
+}
+
+ext_pack_deadline_t get_ExtPack_deadline(uint32_t timeout_us) {
+#if EXT_PACK_TIMEBASE
+    return get_ExtPack_LL_time_us() + timeout_us;
+#else
+    return timeout_us;
+#endif
+}
+
+uint8_t is_ExtPack_deadline_expired(ext_pack_deadline_t* deadline) {
+#if EXT_PACK_TIMEBASE
+    // Difference instead of comparison --> Works across the wrap of the clock
+    return (int32_t)(get_ExtPack_LL_time_us() - *deadline) >= 0;
+#else
+    if (*deadline == 0) {
+        return 1;
+    }
+    (*deadline)--;
+    _delay_us(1);
+    return 0;
+#endif
+}
@@ -0,0 +1,80 @@
+/**
+ * @file ExtPack_Timebase.h
+ *
+ * @brief Monotonic microsecond clock and deadlines for the timeouts of the ExtPack library.
+ *
+ * @layer Core
+ *
+ * @details With EXT_PACK_TIMEBASE = 1 the HAL extends its free running cycle counter by an overflow interrupt
+ * to a microsecond clock (see get_ExtPack_LL_time_us()). A timeout is turned into a deadline of this clock once,
+ * so a wait loop is as long as requested, independent of the duration of its passes and of F_CPU.
+ * The clock runs after init_ExtPack(), also with disabled interrupts (p.ex. in custom ISRs).
+ *
+ * With EXT_PACK_TIMEBASE = 0 (default) the timer stays unused and a deadline counts the wait loop passes instead,
+ * every pass waiting 1 us (the timeout is longer than requested by the duration of the passes).
+ *
+ * ## Features:
+ * - Reading the microsecond clock.
+ * - Checking if the clock runs (p.ex. before init_ExtPack()).
+ * - Creating deadlines from timeouts and checking them in wait loops.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_TIMEBASE_H
+#define EXTPACK_TIMEBASE_H
+
+#include "ExtPack_Defs.h"
+
+/**
+ * @typedef ext_pack_deadline_t
+ * @brief The end of a timeout (clock value with EXT_PACK_TIMEBASE = 1, remaining wait loop passes otherwise).
+ *
+ * @layer Core
+ */
+typedef uint32_t ext_pack_deadline_t;
+
+/**
+ * @brief Checks if the microsecond clock runs.
+ *
+ * @layer Core
+ *
+ * @return 1 after init_ExtPack() with EXT_PACK_TIMEBASE = 1, 0 otherwise.
+ */
+uint8_t is_ExtPack_timebase_running();
+
+/**
+ * @brief Returns the monotonic microsecond clock.
+ *
+ * @layer Core
+ *
+ * @details The clock wraps after about 71 minutes, compare clock values by their difference only.
+ *
+ * @return The microseconds since an arbitrary start (always 0 with EXT_PACK_TIMEBASE = 0).
+ */
+uint32_t get_ExtPack_now_us();
+
+/**
+ * @brief Returns the deadline of a timeout starting now.
+ *
+ * @layer Core
+ *
+ * @param timeout_us The timeout in us (at most 2^31 us).
+ * @return The deadline to pass to is_ExtPack_deadline_expired().
+ */
+ext_pack_deadline_t get_ExtPack_deadline(uint32_t timeout_us);
+
+/**
+ * @brief Checks if a deadline is expired. Call it once per wait loop pass.
+ *
+ * @layer Core
+ *
+ * @details With EXT_PACK_TIMEBASE = 0 every call not expiring waits 1 us and counts down the deadline.
+ *
+ * @param deadline The deadline returned by get_ExtPack_deadline().
+ * @return 1 if the deadline is expired, 0 otherwise.
+ */
+uint8_t is_ExtPack_deadline_expired(ext_pack_deadline_t* deadline);
+
+#endif //EXTPACK_TIMEBASE_H
@@ -0,0 +1,103 @@
+/**
+ * @file ExtPack_Timebase_Internal.h
+ *
+ * @brief State of the microsecond clock for the library initialization and its conversion from clock cycles for the HAL.
+ *
+ * @layer Core
+ *
+ * @warning This file is only for access for ExtPack library functions. The user should not directly use this header file.
+ *
+ * ## Features:
+ * - Marking the clock as running after the HAL started its timer.
+ * - Exact conversion of clock cycles to microseconds for any F_CPU (not only whole MHz).
+ *
+ * @details The function is empty and the conversion constants are not defined with EXT_PACK_TIMEBASE = 0.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_TIMEBASE_INTERNAL_H
+#define EXTPACK_TIMEBASE_INTERNAL_H
+
+#include "ExtPack_Timebase.h"
+
+#if EXT_PACK_TIMEBASE
+/*
+ * F_CPU / 1 MHz as fraction reduced by the largest power of 10 dividing F_CPU
+ * (p.ex. 16 MHz: 16 / 1, 14.7456 MHz: 147456 / 10000, 3.333333 MHz: 3333333 / 1000000).
+ */
+#if F_CPU % 1000000UL == 0
+    #define EXT_PACK_TIMEBASE_US_NUM 1UL
+#elif F_CPU % 100000UL == 0
+    #define EXT_PACK_TIMEBASE_US_NUM 10UL
+#elif F_CPU % 10000UL == 0
+    #define EXT_PACK_TIMEBASE_US_NUM 100UL
+#elif F_CPU % 1000UL == 0
+    #define EXT_PACK_TIMEBASE_US_NUM 1000UL
+#elif F_CPU % 100UL == 0
+    #define EXT_PACK_TIMEBASE_US_NUM 10000UL
+#elif F_CPU % 10UL == 0
+    #define EXT_PACK_TIMEBASE_US_NUM 100000UL
+#else
+    #define EXT_PACK_TIMEBASE_US_NUM 1000000UL
+#endif
+
+/**
+ * @def EXT_PACK_TIMEBASE_CYCLES_DEN
+ * @brief Microseconds of clock cycles: us = cycles * EXT_PACK_TIMEBASE_US_NUM / EXT_PACK_TIMEBASE_CYCLES_DEN (exact).
+ *
+ * @layer Core
+ */
+#define EXT_PACK_TIMEBASE_CYCLES_DEN (F_CPU / (1000000UL / EXT_PACK_TIMEBASE_US_NUM))
+
+/**
+ * @def EXT_PACK_TIMEBASE_OVERFLOW_US
+ * @brief Whole microseconds of the 65536 clock cycles of a cycle counter overflow.
+ *
+ * @layer Core
+ */
+#define EXT_PACK_TIMEBASE_OVERFLOW_US ((uint32_t)(65536ULL * EXT_PACK_TIMEBASE_US_NUM / EXT_PACK_TIMEBASE_CYCLES_DEN))
+
+/**
+ * @def EXT_PACK_TIMEBASE_OVERFLOW_REST
+ * @brief Remaining fraction of a microsecond of a cycle counter overflow (in 1 / EXT_PACK_TIMEBASE_CYCLES_DEN us).
+ *
+ * @layer Core
+ */
+#define EXT_PACK_TIMEBASE_OVERFLOW_REST ((uint32_t)(65536ULL * EXT_PACK_TIMEBASE_US_NUM % EXT_PACK_TIMEBASE_CYCLES_DEN))
+
+/**
+ * @typedef ext_pack_timebase_calc_t
+ * @brief Type of the conversion of the cycle counter (64 bit only if cycles * EXT_PACK_TIMEBASE_US_NUM does not fit into 32 bit).
+ *
+ * @layer Core
+ */
+#if 65535ULL * EXT_PACK_TIMEBASE_US_NUM + EXT_PACK_TIMEBASE_CYCLES_DEN > 0xFFFFFFFFULL
+typedef uint64_t ext_pack_timebase_calc_t;
+#else
+typedef uint32_t ext_pack_timebase_calc_t;
+#endif
+
+/**
+ * @brief Set after init_ExtPack_LL() started the timer of the clock.
+ *
+ * @layer Core
+ */
+extern volatile uint8_t ExtPack_timebase_running;
+#endif
+
+/**
+ * @brief Marks the microsecond clock as running.
+ *
+ * @layer Core
+ *
+ * @note Only call it after init_ExtPack_LL().
+ */
+static inline void set_ExtPack_timebase_running() {
+#if EXT_PACK_TIMEBASE
+    ExtPack_timebase_running = 1;
+#endif
+}
+
+#endif //EXTPACK_TIMEBASE_INTERNAL_H
@@ -10,7 +10,7 @@
  *
  * ## Features:
  * - Low-level initialization of hardware resources.
- * - Raw UART command transmission to ExtPack units.
+ * - Raw UART command transmission to ExtPack units (single commands and blocks).
  * - Basic critical section handling using interrupt control.
  *
  * This layer operates without validation or abstraction and is used internally by higher-level ExtPack logic.
@@ -52,6 +52,15 @@
  */
 #define EXT_PACK_UART_BITS_PER_COMMAND_PAIR 20
 
+/**
+ * @def EXT_PACK_PACE_TICK_US
+ *
+ * @layer HAL
+ *
+ * @brief The period of the pace timer in us (resolution of the gaps of paced sends).
+ */
+#define EXT_PACK_PACE_TICK_US 100
+
 /**
  * @brief Initializes the hardware used for interactions with ExtPack.
  *
@@ -65,6 +74,11 @@ void init_ExtPack_LL();
  *
  * @layer HAL
  *
+ * @note With a send buffer (SEND_BUF_LEN > 0) the RX complete interrupt and the pace timer interrupt are masked while the command
+ * is added to the buffer. The global interrupt flag is only cleared for the few clock cycles of the read-modify-writes of the
+ * UART and timer control registers (masking and unmasking).
+ * Call it from the main context or custom ISRs only, as calls from other ISRs are not excluded.
+ *
  * @param unit The unit number (bit 0-5) and the access mode bits (bit 6-7).
  * @param data The data to send.
  * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on failure.
@@ -72,19 +86,201 @@ void init_ExtPack_LL();
 ext_pack_error_t send_UART_ExtPack_command(unit_t unit, uint8_t data);
 
 /**
- * @brief Saves the interrupt state and disables interrupts.
+ * @brief Sends a block of ExtPack commands with the same unit byte via UART.
+ * The commands are not checked for consistency, syntax or semantic.
+ *
+ * @layer HAL
+ *
+ * @details Adds as many commands as fit into the send buffer in one go (the RX complete interrupt is masked only once).
+ * Without send buffer (SEND_BUF_LEN = 0) at most one command is sent.
+ *
+ * @note Call it from the main context or custom ISRs only (see send_UART_ExtPack_command()).
+ *
+ * @param unit The unit number (bit 0-5) and the access mode bits (bit 6-7) of all commands.
+ * @param data The data bytes to send.
+ * @param len The amount of data bytes.
+ * @return The amount of sent (buffered) data bytes, beginning with the first one.
+ */
+uint8_t send_UART_ExtPack_commands(unit_t unit, const uint8_t* data, uint8_t len);
+
+/**
+ * @brief Sends all commands or none of them via UART (transaction).
+ * The commands are not checked for consistency, syntax or semantic.
+ *
+ * @layer HAL
+ *
+ * @details The commands are added to the send buffer in one go with the same exclusion as send_UART_ExtPack_command(),
+ * so no other producer (custom ISRs, pace timer) can add commands in between.
+ * Without send buffer (SEND_BUF_LEN = 0) only transactions with one command are possible.
+ *
+ * @note Call it from the main context or custom ISRs only (see send_UART_ExtPack_command()).
+ *
+ * @param commands The commands to send.
+ * @param amount The amount of commands.
+ * @return EXT_PACK_SUCCESS if all commands are buffered, EXT_PACK_FAILURE if not enough slots are free (nothing buffered).
+ */
+ext_pack_error_t send_UART_ExtPack_transaction(const ext_pack_command_t* commands, uint8_t amount);
+
+#if EXT_PACK_TX_COALESCING
+/**
+ * @brief Sends a command pair via UART, replacing the data of the newest queued command pair if it has the same unit byte.
+ * The data is not checked for consistency, syntax or semantic.
+ *
+ * @layer HAL
+ *
+ * @details Only the newest queued command pair of the send buffer is replaced, so the new data overtakes no command pair
+ * (the order of the commands of all units is kept). Otherwise (and without send buffer) the same as send_UART_ExtPack_command().
+ * The consumer of the send buffer is paused while the queued command pairs are searched.
+ *
+ * @note Call it from the main context or custom ISRs only (see send_UART_ExtPack_command()).
+ *
+ * @param unit The unit and access mode to which the data should be sent.
+ * @param data The data to be sent.
+ * @return EXT_PACK_SUCCESS if the data is queued, EXT_PACK_FAILURE if the send buffer is full.
+ */
+ext_pack_error_t send_UART_ExtPack_command_coalesced(unit_t unit, uint8_t data);
+#endif
+
+/**
+ * @brief Returns the maximum amount of commands of a transaction.
+ *
+ * @layer HAL
+ *
+ * @return The size of the send buffer (1 without send buffer).
+ */
+uint8_t get_UART_ExtPack_tx_capacity();
+
+/**
+ * @brief Returns the amount of commands which can be sent without failing.
+ *
+ * @layer HAL
+ *
+ * @return The amount of free slots in the send buffer (without send buffer: 1 if the UART is free, 0 otherwise).
+ */
+uint8_t get_UART_ExtPack_free_slots();
+
+/**
+ * @brief Returns if all commands are sent completely (including the stop bit of the last byte).
+ *
+ * @layer HAL
+ *
+ * @return 1 if all commands are sent, 0 otherwise.
+ */
+uint8_t is_UART_ExtPack_tx_complete();
+
+/**
+ * @brief Enables the TX complete interrupt calling process_ExtPack_tx_complete() once when all commands are sent.
+ *
+ * @layer HAL
+ *
+ * @note Call it in a critical zone after checking is_UART_ExtPack_tx_complete(), as a completed send does not trigger it
+ * when nothing was sent before.
+ */
+void notify_UART_ExtPack_tx_complete();
+
+/**
+ * @brief Disables interrupts and returns the interrupt state before.
+ *
+ * @layer HAL
+ *
+ * @return The interrupt state to pass to exit_critical_zone.
+ */
+uint8_t enter_critical_zone();
+
+/**
+ * @brief Resets the interrupt state to the one returned by enter_critical_zone.
+ *
+ * @layer HAL
+ *
+ * @param interrupt_state The interrupt state returned by the matching enter_critical_zone.
+ */
+void exit_critical_zone(uint8_t interrupt_state);
+
+/**
+ * @brief Returns the value of the free running clock cycle counter used for profiling.
+ *
+ * @layer HAL
+ *
+ * @details Only available with EXT_PACK_PROFILING = 1. The counter is a 16 bit timer without prescaler:
+ * - ATmega328P: Timer1
+ * - megaAVR 0-series and tinyAVR 1-series: TCB0
+ * - Host: CLOCK_MONOTONIC converted to F_CPU clock cycles
+ *
+ * @return The current counter value.
+ */
+uint16_t get_ExtPack_LL_cycles();
+
+/**
+ * @brief Returns the monotonic microsecond clock of the timebase.
+ *
+ * @layer HAL
+ *
+ * @details Only available with EXT_PACK_TIMEBASE = 1. The clock is the cycle counter of get_ExtPack_LL_cycles()
+ * with an overflow interrupt adding the microseconds of every 65536 clock cycles:
+ * - ATmega328P: Timer1 overflow
+ * - megaAVR 0-series and tinyAVR 1-series: TCB0 capture (compare) interrupt
+ * - Host: CLOCK_MONOTONIC
+ *
+ * @return The microseconds since an arbitrary start (wraps after about 71 minutes).
+ */
+uint32_t get_ExtPack_LL_time_us();
+
+/**
+ * @brief Sleeps in idle sleep mode until the next interrupt (RX complete, timebase overflow, ...).
  *
  * @layer HAL
+ *
+ * @details Only available with EXT_PACK_SLEEP_WAIT = 1. Call it in a critical zone after checking the wake-up condition.
+ * The interrupts are enabled directly before sleeping, so an interrupt after the check wakes the controller.
+ * Returns at once if the interrupts were disabled before the critical zone (p.ex. in custom ISRs), as nothing would wake the controller.
+ * The host only leaves all nested critical zones, yields the processor and enters them again (returns at once in custom ISRs).
+ *
+ * @param interrupt_state The interrupt state returned by enter_critical_zone() of the critical zone.
  */
-void enter_critical_zone();
+void sleep_ExtPack_LL_idle(uint8_t interrupt_state);
 
 /**
- * @brief Resets the interrupt state to the last saved one from enter_critical_zone.
+ * @brief Sleeps in standby sleep mode until the next interrupt, the start of a received frame wakes the controller.
  *
  * @layer HAL
+ *
+ * @details Only available with EXT_PACK_STANDBY = 1. Enables the start-of-frame detection and the receive start interrupt
+ * of the USART (megaAVR 0-series and tinyAVR 1-series) while sleeping and counts the wake-ups (see ExtPack_Standby_Internal.h).
+ * Does not sleep while sending, while paced sends are running or between the bytes of a received command pair.
+ * The ATmega328P and the host do not support it.
+ *
+ * @return EXT_PACK_SUCCESS after sleeping, EXT_PACK_FAILURE if not sleeping.
  */
-void exit_critical_zone();
+ext_pack_error_t sleep_ExtPack_LL_standby();
+
+/**
+ * @brief Starts the pace timer calling process_ExtPack_pace_tick() every EXT_PACK_PACE_TICK_US (if not running yet).
+ *
+ * @layer HAL
+ *
+ * @details Only available with EXT_PACK_PACED_JOBS > 0. The pace timer is:
+ * - ATmega328P: Timer2
+ * - megaAVR 0-series: TCB1
+ * - tinyAVR 1-series: TCD0
+ * - Host: Pacing thread
+ *
+ * @note Call it in a critical zone.
+ */
+void start_ExtPack_LL_pace_timer();
+
+/**
+ * @brief Stops the pace timer.
+ *
+ * @layer HAL
+ *
+ * @note Only called by process_ExtPack_pace_tick().
+ */
+void stop_ExtPack_LL_pace_timer();
 
 extern void process_received_ExtPack_data(unit_t unit, uint8_t data);
 
+extern void process_ExtPack_pace_tick();
+
+extern void process_ExtPack_tx_complete();
+
 #endif //EXTPACK_LL_H
\ No newline at end of file
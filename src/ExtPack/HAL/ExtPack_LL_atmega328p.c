@@ -1,6 +1,10 @@
 #include "ExtPack_LL.h"
+#include "../Core/ExtPack_Link_Stats_Internal.h"
+#include "../Core/ExtPack_Profiling_Internal.h"
+#include "../Core/ExtPack_Timebase_Internal.h"
 #include "avr/io.h"
 #include "avr/interrupt.h"
+#include "avr/sleep.h"
 
 /**
  * @def BAUD_CONST
@@ -46,23 +50,26 @@ volatile state_type recv_state = RECV_UNIT_NEXT_STATE;
 #if SEND_BUF_LEN > 0
 #include "../Core/ExtPack_Ringbuffer_Internal.h"
 
-volatile ringbuffer_elem_t send_buf[SEND_BUF_LEN];
-volatile ringbuffer_metadata_t send_buf_metadata;
+DEFINE_RINGBUFFER(send_buf, uint16_t, SEND_BUF_LEN)
+volatile send_buf_t send_buf;
 
 volatile uint8_t next_data_to_send_is_buffer_pair = 1;
 #endif
 
 volatile uint8_t next_data_to_send;
-volatile unit_t received_unit;
 
-volatile uint8_t ExtPack_LL_SREG_save;
+/*
+ * Set while nothing was sent since the last TX complete (also after init) as the TX complete flag is not set then.
+ */
+volatile uint8_t tx_idle = 1;
+volatile unit_t received_unit;
 
 // ----------------------------------------- Init ------------------------------------------
 
 void init_ExtPack_LL() {
 #if SEND_BUF_LEN > 0
     // ------- Init ringbuffer -------
-    init_ringbuffer_metadata(send_buf, SEND_BUF_LEN, &send_buf_metadata);
+    init_send_buf(&send_buf);
 #endif
     /*
      * ---------- Init UART ----------
@@ -88,28 +95,102 @@ void init_ExtPack_LL() {
     // Set prescaler to /8
     TCCR0B &= ~((1 << CS02) | (1 << CS01) | (1 << CS00));
     TCCR0B |= ( 1 << CS01);
+#if EXT_PACK_PROFILING || EXT_PACK_TIMEBASE
+    /*
+     * ---------- Init cycle counter ----------
+     * Timer1 free running without prescaler (overflow interrupt extends it to the clock of the timebase)
+     */
+    TCCR1A = 0;
+    TCCR1B = (1 << CS10);
+#endif
+#if EXT_PACK_TIMEBASE
+    TIMSK1 |= (1 << TOIE1);
+#endif
+#if EXT_PACK_PACED_JOBS > 0
+    /*
+     * ---------- Init pace timer ----------
+     * Timer2 in CTC mode, /64 prescaler --> 16 MHz / 64 = 250 kHz
+     * --> Compare match every EXT_PACK_PACE_TICK_US (100 us = 25 timer clock cycles)
+     * Started by start_ExtPack_LL_pace_timer()
+     * Timer clock cycles rounded up --> the tick is never shorter than EXT_PACK_PACE_TICK_US
+     */
+    #define PACE_TIMER_CYCLES ((F_CPU * 1ULL * EXT_PACK_PACE_TICK_US + 64000000ULL - 1) / 64000000ULL)
+    #if PACE_TIMER_CYCLES == 0
+        #error EXT_PACK_PACE_TICK_US must not be 0!
+    #elif PACE_TIMER_CYCLES > 256
+        #error EXT_PACK_PACE_TICK_US too long for the 8 bit Timer2!
+    #endif
+    TCCR2A = (1 << WGM21);
+    OCR2A = PACE_TIMER_CYCLES - 1;
+#endif
     // Enable global interrupt
     sei();
 }
 
 // ---------------------------------------- Sending ----------------------------------------
 
-ext_pack_error_t send_UART_ExtPack_command(unit_t unit, uint8_t data) {
+#if EXT_PACK_PACED_JOBS > 0
+/*
+ * Set while the pace timer runs. Only changed by start_ExtPack_LL_pace_timer() and stop_ExtPack_LL_pace_timer(),
+ * the interrupt enable bit is also cleared while the send buffer is written.
+ */
+volatile uint8_t pace_timer_running = 0;
+#endif
+
 #if SEND_BUF_LEN > 0
+/*
+ * Masks the interrupts of the other producers of the send buffer (RX complete and pace timer interrupt).
+ * Returns the enable bit of the RX complete interrupt for restore_send_producers(),
+ * the pace timer interrupt is restored from pace_timer_running (a stop by the pace ISR is not undone).
+ */
+static inline uint8_t mask_send_producers() {
+    // Interrupts disabled during the read-modify-writes --> The ISRs can not change the bits in between
+    uint8_t interrupt_state = SREG;
+    cli();
+    uint8_t producers_enabled = UCSR0B & (1<<RXCIE0);
+    UCSR0B &= ~(1<<RXCIE0);
+#if EXT_PACK_PACED_JOBS > 0
+    TIMSK2 &= ~(1<<OCIE2A); // Restored if the pace timer is still running
+#endif
+    SREG = interrupt_state;
+    return producers_enabled;
+}
+
+/*
+ * Activates the data register empty interrupt (deactivated by the ISR when the buffer is empty)
+ * and restores the interrupts masked by mask_send_producers().
+ */
+static inline void restore_send_producers(uint8_t producers_enabled) {
+    uint8_t interrupt_state = SREG;
     cli();
-    uint8_t is_first_command = is_buf_empty(&send_buf_metadata);
+    UCSR0B |= (1<<UDRIE0) | (producers_enabled & (1<<RXCIE0));
+#if EXT_PACK_PACED_JOBS > 0
+    if (pace_timer_running) {
+        TIMSK2 |= (1<<OCIE2A);
+    }
+#endif
+    SREG = interrupt_state;
+}
+#endif
+
+ext_pack_error_t send_UART_ExtPack_command(unit_t unit, uint8_t data) {
+#if SEND_BUF_LEN > 0
+    /*
+     * The ringbuffer is lock-free between this function (producer) and the data register empty ISR (consumer).
+     * Custom ISRs called by the RX complete ISR and the pace timer ISR are the only other producers
+     * --> Only their interrupts are masked, all other interrupts stay enabled.
+     */
+    uint8_t producers_enabled = mask_send_producers();
     // Add to buffer
     uint16_t buf_data = ((uint16_t)unit<<8) | data;
-    uint8_t ret = write_buf(&send_buf_metadata, buf_data);
-    if (is_first_command && ret == EXT_PACK_SUCCESS) {
-        // Activate data register empty interrupt
-        UCSR0B |= (1 << UDRIE0);
-    }
-    sei();
+    uint8_t ret = write_send_buf(&send_buf, buf_data);
+    count_ExtPack_link_send(ret, get_send_buf_used_slots(&send_buf));
+    restore_send_producers(producers_enabled);
     return ret;
 #else
+    // Enter critical zone, the interrupt state is restored afterwards (custom ISRs send with disabled interrupts)
+    uint8_t interrupt_state = SREG;
     cli();
-    // Enter critical zone
     // Send data if:
     // - UART data register is empty
     // - Data register empty interrupt is not active (so no data is in queue to be sent)
@@ -122,26 +203,141 @@ ext_pack_error_t send_UART_ExtPack_command(unit_t unit, uint8_t data) {
         next_data_to_send = data;
         // Activate data register empty interrupt
         UCSR0B |= (1 << UDRIE0);
-        sei(); // Exit critical zone
+        count_ExtPack_link_send(EXT_PACK_SUCCESS, 1);
+        SREG = interrupt_state; // Exit critical zone
         return EXT_PACK_SUCCESS;
         } else {
             // Not ready to send data pair
-            sei(); // Exit critical zone
+            count_ExtPack_link_send(EXT_PACK_FAILURE, 0);
+            SREG = interrupt_state; // Exit critical zone
             return EXT_PACK_FAILURE;
         }
 #endif
 }
 
+uint8_t send_UART_ExtPack_commands(unit_t unit, const uint8_t* data, uint8_t len) {
+#if SEND_BUF_LEN > 0
+    // Same exclusion as send_UART_ExtPack_command, but only once for the whole block
+    uint8_t producers_enabled = mask_send_producers();
+    uint8_t amount_sent = 0;
+    while (amount_sent < len && write_send_buf(&send_buf, ((uint16_t)unit<<8) | data[amount_sent]) == EXT_PACK_SUCCESS) {
+        amount_sent++;
+        count_ExtPack_link_send(EXT_PACK_SUCCESS, get_send_buf_used_slots(&send_buf));
+    }
+    if (amount_sent < len) {
+        count_ExtPack_link_send(EXT_PACK_FAILURE, 0);
+    }
+    restore_send_producers(producers_enabled);
+    return amount_sent;
+#else
+    // Only one command pair fits into the UART
+    return len > 0 && send_UART_ExtPack_command(unit, data[0]) == EXT_PACK_SUCCESS;
+#endif
+}
+
+ext_pack_error_t send_UART_ExtPack_transaction(const ext_pack_command_t* commands, uint8_t amount) {
+#if SEND_BUF_LEN > 0
+    // Same exclusion as send_UART_ExtPack_command --> The free slots can not be taken by another producer
+    uint8_t producers_enabled = mask_send_producers();
+    uint8_t ret = EXT_PACK_FAILURE;
+    if (SEND_BUF_LEN - get_send_buf_used_slots(&send_buf) >= amount) {
+        for (uint8_t i = 0; i < amount; i++) {
+            write_send_buf(&send_buf, ((uint16_t)commands[i].unit<<8) | commands[i].data);
+            count_ExtPack_link_send(EXT_PACK_SUCCESS, get_send_buf_used_slots(&send_buf));
+        }
+        ret = EXT_PACK_SUCCESS;
+    } else {
+        count_ExtPack_link_send(EXT_PACK_FAILURE, 0);
+    }
+    restore_send_producers(producers_enabled);
+    return ret;
+#else
+    // Only one command pair fits into the UART
+    if (amount > 1) {
+        count_ExtPack_link_send(EXT_PACK_FAILURE, 0);
+        return EXT_PACK_FAILURE;
+    }
+    return amount == 0 ? EXT_PACK_SUCCESS : send_UART_ExtPack_command(commands[0].unit, commands[0].data);
+#endif
+}
+
+#if EXT_PACK_TX_COALESCING
+ext_pack_error_t send_UART_ExtPack_command_coalesced(unit_t unit, uint8_t data) {
+#if SEND_BUF_LEN > 0
+    // The data register empty ISR (consumer) is masked too --> No queued command pair is taken out while it is replaced
+    uint8_t producers_enabled = mask_send_producers();
+    uint8_t interrupt_state = SREG;
+    cli(); // The TX complete ISR changes UCSR0B too
+    UCSR0B &= ~(1<<UDRIE0);
+    SREG = interrupt_state;
+    // Only the newest queued command pair --> No command pair of another unit is overtaken by the new data
+    if (get_send_buf_used_slots(&send_buf) > 0) {
+        volatile uint16_t* queued = peek_send_buf(&send_buf, 0);
+        if ((uint8_t)(*queued >> 8) == unit) {
+            *queued = ((uint16_t)unit<<8) | data;
+            COUNT_EXT_PACK_LINK_STAT(tx_coalesced);
+            restore_send_producers(producers_enabled);
+            return EXT_PACK_SUCCESS;
+        }
+    }
+    uint8_t ret = write_send_buf(&send_buf, ((uint16_t)unit<<8) | data);
+    count_ExtPack_link_send(ret, get_send_buf_used_slots(&send_buf));
+    restore_send_producers(producers_enabled); // Also activates the data register empty interrupt again
+    return ret;
+#else
+    // Nothing is queued without send buffer
+    return send_UART_ExtPack_command(unit, data);
+#endif
+}
+#endif
+
+uint8_t get_UART_ExtPack_tx_capacity() {
+    return SEND_BUF_LEN > 0 ? SEND_BUF_LEN : 1;
+}
+
+uint8_t get_UART_ExtPack_free_slots() {
+#if SEND_BUF_LEN > 0
+    return SEND_BUF_LEN - get_send_buf_used_slots(&send_buf);
+#else
+    return (UCSR0A & (1<<UDRE0)) && !(UCSR0B & (1<<UDRIE0));
+#endif
+}
+
+uint8_t is_UART_ExtPack_tx_complete() {
+    return !(UCSR0B & (1<<UDRIE0)) && (tx_idle || (UCSR0A & (1<<TXC0)));
+}
+
+void notify_UART_ExtPack_tx_complete() {
+    // Interrupts disabled during the read-modify-write --> The UART ISRs can not change UCSR0B in between
+    uint8_t interrupt_state = SREG;
+    cli();
+    UCSR0B |= (1<<TXCIE0);
+    SREG = interrupt_state;
+}
+
+/*
+ * Calls process_ExtPack_tx_complete once when all command pairs are sent (enabled by notify_UART_ExtPack_tx_complete)
+ */
+ISR(USART_TX_vect) {
+    if (UCSR0B & (1<<UDRIE0)) {
+        return; // Flag of a gap between two sends --> Wait for the end of the running send
+    }
+    tx_idle = 1; // TX complete flag is cleared now
+    UCSR0B &= ~(1<<TXCIE0);
+    process_ExtPack_tx_complete();
+}
+
 /*
  * Sends next buffer data pair or second part of data pair
  */
 ISR(USART_UDRE_vect) {
+    EXT_PACK_PROFILE_START(profile_start);
 #if SEND_BUF_LEN > 0
     // UART data register empty
     if(next_data_to_send_is_buffer_pair) {
         // Send buffer data
         uint16_t data;
-        if(read_buf(&send_buf_metadata, &data) == EXT_PACK_SUCCESS) {
+        if(read_send_buf(&send_buf, &data) == EXT_PACK_SUCCESS) {
             UDR0 = (uint8_t)(data >> 8);
             next_data_to_send = (uint8_t)data;
             next_data_to_send_is_buffer_pair = 0;
@@ -154,9 +350,12 @@ ISR(USART_UDRE_vect) {
         // Send data part of message
         UDR0 = next_data_to_send;
         // Check if command in buffer needs to be sent
-        if (is_buf_empty(&send_buf_metadata)) {
+        if (is_send_buf_empty(&send_buf)) {
             // Deactivate data register empty interrupt as no data in queue
             UCSR0B &= ~(1<<UDRIE0);
+            // Last byte --> TX complete flag is set again when it left the shift register
+            UCSR0A = (UCSR0A & ((1<<U2X0)|(1<<MPCM0))) | (1<<TXC0); // Clears TXC0, FE0, DOR0 and UPE0 have to be written as 0
+            tx_idle = 0;
         }
     }
 #else
@@ -164,8 +363,11 @@ ISR(USART_UDRE_vect) {
     UDR0 = next_data_to_send;
     // Deactivate data register empty interrupt
     UCSR0B &= ~(1<<UDRIE0);
+    // TX complete flag is set again when the data byte left the shift register
+    UCSR0A = (UCSR0A & ((1<<U2X0)|(1<<MPCM0))) | (1<<TXC0); // Clears TXC0, FE0, DOR0 and UPE0 have to be written as 0
+    tx_idle = 0;
 #endif
-
+    EXT_PACK_PROFILE_END(EXT_PACK_PROFILE_DRE_ISR, profile_start);
 }
 
 // --------------------------------------- Receiving ---------------------------------------
@@ -175,8 +377,10 @@ ISR(USART_UDRE_vect) {
  * Also manages received data for units.
  */
 ISR(USART_RX_vect) {
+    EXT_PACK_PROFILE_START(profile_start);
     uint8_t errors = UCSR0A;
     uint8_t received_data = UDR0;
+    count_ExtPack_link_receive_errors(errors & (1<<FE0), errors & (1<<UPE0), errors & (1<<DOR0));
     if(recv_state == RECV_UNIT_NEXT_STATE) {
         // Received unit number
         received_unit = received_data;
@@ -207,25 +411,134 @@ ISR(USART_RX_vect) {
         // Disables state machine reset timer
         TIMSK0 &= ~(1 << TOIE0);
     }
+    EXT_PACK_PROFILE_END(EXT_PACK_PROFILE_RX_ISR, profile_start);
 }
 
 /*
  * Resets state machine when timer/counter0 has an overflow
  */
 ISR(TIMER0_OVF_vect) {
+    EXT_PACK_PROFILE_START(profile_start);
     //Reset state machine
+    COUNT_EXT_PACK_LINK_STAT(resyncs);
     recv_state = RECV_UNIT_NEXT_STATE;
     // Disables timer interrupts
     TIMSK0 &= ~(1 << TOIE0);
+    EXT_PACK_PROFILE_END(EXT_PACK_PROFILE_RESYNC_ISR, profile_start);
 }
 
+// ---------------------------------------- Pacing -----------------------------------------
+
+#if EXT_PACK_PACED_JOBS > 0
+void start_ExtPack_LL_pace_timer() {
+    if (pace_timer_running) {
+        return; // Already running
+    }
+    pace_timer_running = 1;
+    TCNT2 = 0;
+    TIFR2 = (1 << OCF2A); // Reset interrupt flag
+    TIMSK2 |= (1 << OCIE2A);
+    TCCR2B = (1 << CS22); // Start with /64 prescaler
+}
+
+void stop_ExtPack_LL_pace_timer() {
+    TCCR2B = 0;
+    TIMSK2 &= ~(1 << OCIE2A);
+    pace_timer_running = 0;
+}
+
+/*
+ * Feeds the running paced sends into the send buffer
+ */
+ISR(TIMER2_COMPA_vect) {
+    EXT_PACK_PROFILE_START(profile_start);
+    process_ExtPack_pace_tick();
+    EXT_PACK_PROFILE_END(EXT_PACK_PROFILE_PACE_ISR, profile_start);
+}
+#endif
+
+// ---------------------------------------- Timebase ---------------------------------------
+
+#if EXT_PACK_TIMEBASE
+/*
+ * Microseconds and remaining fraction of a microsecond (in 1 / EXT_PACK_TIMEBASE_CYCLES_DEN us) of all cycle counter overflows
+ */
+volatile uint32_t time_overflow_us = 0;
+volatile uint32_t time_overflow_rest = 0;
+
+/*
+ * Adds the 65536 clock cycles of an overflow (constants --> no division at runtime)
+ */
+static inline void add_time_overflow() {
+    time_overflow_us += EXT_PACK_TIMEBASE_OVERFLOW_US;
+    time_overflow_rest += EXT_PACK_TIMEBASE_OVERFLOW_REST;
+    if (time_overflow_rest >= EXT_PACK_TIMEBASE_CYCLES_DEN) {
+        time_overflow_us++;
+        time_overflow_rest -= EXT_PACK_TIMEBASE_CYCLES_DEN;
+    }
+}
+
+uint32_t get_ExtPack_LL_time_us() {
+    uint8_t interrupt_state = enter_critical_zone();
+    uint16_t cycles = TCNT1;
+    if (TIFR1 & (1 << TOV1)) {
+        // Overflow not handled by the ISR yet (interrupts disabled) --> Handle it here
+        TIFR1 = (1 << TOV1);
+        add_time_overflow();
+        cycles = TCNT1;
+    }
+    uint32_t time_us = time_overflow_us
+        + (uint32_t)((time_overflow_rest + (ext_pack_timebase_calc_t)cycles * EXT_PACK_TIMEBASE_US_NUM) / EXT_PACK_TIMEBASE_CYCLES_DEN);
+    exit_critical_zone(interrupt_state);
+    return time_us;
+}
+
+/*
+ * Extends the cycle counter to the microsecond clock
+ */
+ISR(TIMER1_OVF_vect) {
+    add_time_overflow();
+}
+#endif
+
+// ---------------------------------------- Sleeping ---------------------------------------
+
+#if EXT_PACK_SLEEP_WAIT
+void sleep_ExtPack_LL_idle(uint8_t interrupt_state) {
+    if (!(interrupt_state & (1 << SREG_I))) {
+        return; // Interrupts disabled by the caller --> Nothing would wake the controller
+    }
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sei(); // The instruction after sei() is executed before any interrupt --> No interrupt is missed before sleeping
+    sleep_cpu();
+    sleep_disable();
+    cli(); // Back in the critical zone
+}
+#endif
+
+// ---------------------------------------- Standby ----------------------------------------
+
+#if EXT_PACK_STANDBY
+ext_pack_error_t sleep_ExtPack_LL_standby() {
+    return EXT_PACK_FAILURE; // No wake-up by received frames from a sleep mode stopping the clock
+}
+#endif
+
 // ---------------------------------------- Utility ----------------------------------------
 
-void enter_critical_zone() {
-    ExtPack_LL_SREG_save = SREG;
+#if EXT_PACK_PROFILING
+uint16_t get_ExtPack_LL_cycles() {
+    return TCNT1;
+}
+#endif
+
+uint8_t enter_critical_zone() {
+    uint8_t interrupt_state = SREG;
     cli();
+    return interrupt_state;
 }
 
-void exit_critical_zone() {
-    SREG = ExtPack_LL_SREG_save;
+void exit_critical_zone(uint8_t interrupt_state) {
+    SREG = interrupt_state;
 }
\ No newline at end of file
@@ -0,0 +1,541 @@
+#include "ExtPack_LL.h"
+#include "../Core/ExtPack_Link_Stats_Internal.h"
+#include "../Core/ExtPack_Profiling_Internal.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @def EXT_PACK_HOST_DEFAULT_DEVICE
+ * @brief Serial device (tty or pty) used when the environment variable EXT_PACK_HOST_DEVICE is not set.
+ */
+#ifndef EXT_PACK_HOST_DEFAULT_DEVICE
+    #define EXT_PACK_HOST_DEFAULT_DEVICE "/dev/ttyUSB0"
+#endif
+
+/**
+ * @def EXT_PACK_HOST_RESYNC_TIMEOUT_MS
+ * @brief Maximum time in ms between the unit and the data byte of a command pair before the receive state machine is reset.
+ *
+ * @details Much larger than on the microcontrollers as USB-serial adapters deliver the received bytes in chunks.
+ */
+#ifndef EXT_PACK_HOST_RESYNC_TIMEOUT_MS
+    #define EXT_PACK_HOST_RESYNC_TIMEOUT_MS 10
+#endif
+
+/**
+ * @def state_type
+ * @brief Type alias for the UART receive state machine state.
+ */
+#define state_type uint8_t
+
+/**
+ * @def RECV_UNIT_NEXT_STATE
+ * @brief UART receive state where a unit identifier byte is expected next.
+ */
+#define RECV_UNIT_NEXT_STATE 0
+
+/**
+ * @def RECV_DATA_NEXT_STATE
+ * @brief UART receive state where the data byte is expected next.
+ */
+#define RECV_DATA_NEXT_STATE 1
+
+volatile state_type recv_state = RECV_UNIT_NEXT_STATE;
+
+#ifndef SEND_BUF_LEN
+    #warning SEND_BUF_LEN not defined! Setting default value (64).
+    #define SEND_BUF_LEN 64
+#endif
+#if SEND_BUF_LEN % 2 != 0
+    #error SEND_BUF_LEN not even or too small!
+#endif
+
+#if SEND_BUF_LEN > 0
+#include "../Core/ExtPack_Ringbuffer_Internal.h"
+
+DEFINE_RINGBUFFER(send_buf, uint16_t, SEND_BUF_LEN)
+volatile send_buf_t send_buf;
+#else
+volatile uint16_t next_command_to_send;
+volatile uint8_t next_command_to_send_is_pending = 0;
+#endif
+
+volatile unit_t received_unit;
+
+/*
+ * Set by the writer thread while it writes command pairs taken out of the send buffer.
+ */
+volatile uint8_t ExtPack_LL_tx_busy = 0;
+
+/*
+ * Replaces the TX complete interrupt enable bit of the microcontrollers.
+ */
+volatile uint8_t ExtPack_LL_tx_complete_notify = 0;
+
+int ExtPack_LL_fd = -1;
+
+/*
+ * Replaces the interrupt flag of the microcontrollers.
+ * Held by the reader thread while calling process_received_ExtPack_data (like an ISR with interrupts disabled)
+ * and by everyone in a critical zone. Recursive as custom ISRs are allowed to send.
+ */
+pthread_mutex_t ExtPack_LL_lock;
+
+/*
+ * Recursion depth of the critical zones (enter_critical_zone()) of the calling thread,
+ * so sleep_ExtPack_LL_idle() is able to release ExtPack_LL_lock completely.
+ */
+static _Thread_local uint8_t ExtPack_LL_critical_depth = 0;
+
+/*
+ * Set in the threads replacing the ISRs (reader, writer and pacing thread), their custom ISRs must not release ExtPack_LL_lock.
+ */
+static _Thread_local uint8_t ExtPack_LL_is_ISR = 0;
+
+/*
+ * Signals the writer thread that there is something to send.
+ * Always used together with ExtPack_LL_lock.
+ */
+pthread_cond_t ExtPack_LL_send_cond = PTHREAD_COND_INITIALIZER;
+
+pthread_t ExtPack_LL_reader_thread;
+pthread_t ExtPack_LL_writer_thread;
+
+static void* ExtPack_LL_reader(void* arg);
+static void* ExtPack_LL_writer(void* arg);
+
+#if EXT_PACK_PACED_JOBS > 0
+/*
+ * Replaces the pace timer interrupt enable bit of the microcontrollers.
+ * Always used together with ExtPack_LL_lock.
+ */
+volatile uint8_t ExtPack_LL_pace_running = 0;
+
+/*
+ * Signals the pacing thread that the pace timer is started.
+ * Always used together with ExtPack_LL_lock.
+ */
+pthread_cond_t ExtPack_LL_pace_cond = PTHREAD_COND_INITIALIZER;
+
+pthread_t ExtPack_LL_pacing_thread;
+
+static void* ExtPack_LL_pacing(void* arg);
+#endif
+
+// ----------------------------------------- Init ------------------------------------------
+
+void init_ExtPack_LL() {
+    pthread_mutexattr_t lock_attr;
+    pthread_mutexattr_init(&lock_attr);
+    pthread_mutexattr_settype(&lock_attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&ExtPack_LL_lock, &lock_attr);
+    pthread_mutexattr_destroy(&lock_attr);
+#if SEND_BUF_LEN > 0
+    // ------- Init ringbuffer -------
+    init_send_buf(&send_buf);
+#endif
+    /*
+     * ---------- Init UART ----------
+     * UART packages: 8N1 with 1 MBAUD
+     * The device is taken from EXT_PACK_HOST_DEVICE, p.ex. a USB-serial adapter or the slave side of a pty.
+     */
+    const char* device = getenv("EXT_PACK_HOST_DEVICE");
+    if (device == NULL) {
+        device = EXT_PACK_HOST_DEFAULT_DEVICE;
+    }
+    ExtPack_LL_fd = open(device, O_RDWR | O_NOCTTY);
+    if (ExtPack_LL_fd < 0) {
+        perror("ExtPack: opening serial device failed");
+        exit(EXIT_FAILURE);
+    }
+    struct termios tty;
+    if (tcgetattr(ExtPack_LL_fd, &tty) == 0) {
+        // Ignored by ptys --> Only an error for real serial devices
+        cfmakeraw(&tty);
+        cfsetispeed(&tty, B1000000);
+        cfsetospeed(&tty, B1000000);
+        tty.c_cflag |= CLOCAL | CREAD;
+        tty.c_cflag &= ~(CSTOPB | PARENB | CRTSCTS);
+        tty.c_cc[VMIN] = 1;
+        tty.c_cc[VTIME] = 0;
+        if (tcsetattr(ExtPack_LL_fd, TCSANOW, &tty) != 0) {
+            perror("ExtPack: configuring serial device failed");
+        }
+        tcflush(ExtPack_LL_fd, TCIOFLUSH);
+    }
+    /*
+     * ---------- Init Threads ----------
+     * The reader thread replaces the RX interrupt, the writer thread the data register empty interrupt.
+     */
+    pthread_create(&ExtPack_LL_reader_thread, NULL, ExtPack_LL_reader, NULL);
+    pthread_create(&ExtPack_LL_writer_thread, NULL, ExtPack_LL_writer, NULL);
+#if EXT_PACK_PACED_JOBS > 0
+    // The pacing thread replaces the pace timer interrupt
+    pthread_create(&ExtPack_LL_pacing_thread, NULL, ExtPack_LL_pacing, NULL);
+#endif
+}
+
+// ---------------------------------------- Sending ----------------------------------------
+
+ext_pack_error_t send_UART_ExtPack_command(unit_t unit, uint8_t data) {
+    uint16_t buf_data = ((uint16_t)unit<<8) | data;
+    // The lock serializes the producers (main and custom ISRs), the writer thread only takes it to take out the queued command pairs
+    pthread_mutex_lock(&ExtPack_LL_lock);
+#if SEND_BUF_LEN > 0
+    // Add to buffer
+    uint8_t ret = write_send_buf(&send_buf, buf_data);
+    count_ExtPack_link_send(ret, get_send_buf_used_slots(&send_buf));
+#else
+    // Send data if no other command is waiting to be sent
+    uint8_t ret = EXT_PACK_FAILURE;
+    if (!next_command_to_send_is_pending) {
+        next_command_to_send = buf_data;
+        next_command_to_send_is_pending = 1;
+        ret = EXT_PACK_SUCCESS;
+    }
+    count_ExtPack_link_send(ret, 1);
+#endif
+    if (ret == EXT_PACK_SUCCESS) {
+        // Wake up writer thread
+        pthread_cond_signal(&ExtPack_LL_send_cond);
+    }
+    pthread_mutex_unlock(&ExtPack_LL_lock);
+    return ret;
+}
+
+uint8_t send_UART_ExtPack_commands(unit_t unit, const uint8_t* data, uint8_t len) {
+    uint8_t amount_sent = 0;
+    pthread_mutex_lock(&ExtPack_LL_lock);
+#if SEND_BUF_LEN > 0
+    while (amount_sent < len && write_send_buf(&send_buf, ((uint16_t)unit<<8) | data[amount_sent]) == EXT_PACK_SUCCESS) {
+        amount_sent++;
+        count_ExtPack_link_send(EXT_PACK_SUCCESS, get_send_buf_used_slots(&send_buf));
+    }
+#else
+    if (len > 0 && !next_command_to_send_is_pending) {
+        next_command_to_send = ((uint16_t)unit<<8) | data[0];
+        next_command_to_send_is_pending = 1;
+        amount_sent = 1;
+        count_ExtPack_link_send(EXT_PACK_SUCCESS, 1);
+    }
+#endif
+    if (amount_sent < len) {
+        count_ExtPack_link_send(EXT_PACK_FAILURE, 0);
+    }
+    if (amount_sent > 0) {
+        // Wake up writer thread
+        pthread_cond_signal(&ExtPack_LL_send_cond);
+    }
+    pthread_mutex_unlock(&ExtPack_LL_lock);
+    return amount_sent;
+}
+
+ext_pack_error_t send_UART_ExtPack_transaction(const ext_pack_command_t* commands, uint8_t amount) {
+    uint8_t ret = EXT_PACK_FAILURE;
+    pthread_mutex_lock(&ExtPack_LL_lock);
+#if SEND_BUF_LEN > 0
+    if (SEND_BUF_LEN - get_send_buf_used_slots(&send_buf) >= amount) {
+        for (uint8_t i = 0; i < amount; i++) {
+            write_send_buf(&send_buf, ((uint16_t)commands[i].unit<<8) | commands[i].data);
+            count_ExtPack_link_send(EXT_PACK_SUCCESS, get_send_buf_used_slots(&send_buf));
+        }
+        ret = EXT_PACK_SUCCESS;
+    }
+#else
+    if (amount == 0) {
+        ret = EXT_PACK_SUCCESS;
+    } else if (amount == 1 && !next_command_to_send_is_pending) {
+        next_command_to_send = ((uint16_t)commands[0].unit<<8) | commands[0].data;
+        next_command_to_send_is_pending = 1;
+        count_ExtPack_link_send(EXT_PACK_SUCCESS, 1);
+        ret = EXT_PACK_SUCCESS;
+    }
+#endif
+    if (ret == EXT_PACK_SUCCESS) {
+        // Wake up writer thread
+        pthread_cond_signal(&ExtPack_LL_send_cond);
+    } else {
+        count_ExtPack_link_send(EXT_PACK_FAILURE, 0);
+    }
+    pthread_mutex_unlock(&ExtPack_LL_lock);
+    return ret;
+}
+
+#if EXT_PACK_TX_COALESCING
+ext_pack_error_t send_UART_ExtPack_command_coalesced(unit_t unit, uint8_t data) {
+#if SEND_BUF_LEN > 0
+    // The writer thread takes the command pairs out under the lock too --> No queued command pair is taken out while it is replaced
+    pthread_mutex_lock(&ExtPack_LL_lock);
+    // Only the newest queued command pair --> No command pair of another unit is overtaken by the new data
+    if (get_send_buf_used_slots(&send_buf) > 0) {
+        volatile uint16_t* queued = peek_send_buf(&send_buf, 0);
+        if ((uint8_t)(*queued >> 8) == unit) {
+            *queued = ((uint16_t)unit<<8) | data;
+            COUNT_EXT_PACK_LINK_STAT(tx_coalesced);
+            pthread_mutex_unlock(&ExtPack_LL_lock);
+            return EXT_PACK_SUCCESS;
+        }
+    }
+    ext_pack_error_t ret = send_UART_ExtPack_command(unit, data); // Recursive lock --> Appended without another producer in between
+    pthread_mutex_unlock(&ExtPack_LL_lock);
+    return ret;
+#else
+    // Nothing is queued without send buffer
+    return send_UART_ExtPack_command(unit, data);
+#endif
+}
+#endif
+
+uint8_t get_UART_ExtPack_tx_capacity() {
+    return SEND_BUF_LEN > 0 ? SEND_BUF_LEN : 1;
+}
+
+uint8_t get_UART_ExtPack_free_slots() {
+#if SEND_BUF_LEN > 0
+    return SEND_BUF_LEN - get_send_buf_used_slots(&send_buf);
+#else
+    return !next_command_to_send_is_pending;
+#endif
+}
+
+uint8_t is_UART_ExtPack_tx_complete() {
+    // Complete as soon as everything is handed over to the serial device
+    pthread_mutex_lock(&ExtPack_LL_lock);
+#if SEND_BUF_LEN > 0
+    uint8_t complete = is_send_buf_empty(&send_buf) && !ExtPack_LL_tx_busy;
+#else
+    uint8_t complete = !next_command_to_send_is_pending && !ExtPack_LL_tx_busy;
+#endif
+    pthread_mutex_unlock(&ExtPack_LL_lock);
+    return complete;
+}
+
+void notify_UART_ExtPack_tx_complete() {
+    pthread_mutex_lock(&ExtPack_LL_lock);
+    ExtPack_LL_tx_complete_notify = 1;
+    pthread_mutex_unlock(&ExtPack_LL_lock);
+}
+
+/*
+ * Sends all buffered command pairs.
+ * Takes as many commands out of the buffer as possible to write them with one system call.
+ */
+static void* ExtPack_LL_writer(void* arg) {
+    ExtPack_LL_is_ISR = 1;
+    uint8_t bytes[(SEND_BUF_LEN > 0 ? SEND_BUF_LEN : 1) * 2];
+    while (1) {
+        uint16_t amount_bytes = 0;
+        pthread_mutex_lock(&ExtPack_LL_lock);
+#if SEND_BUF_LEN > 0
+        while (is_send_buf_empty(&send_buf)) {
+            pthread_cond_wait(&ExtPack_LL_send_cond, &ExtPack_LL_lock);
+        }
+        ExtPack_LL_tx_busy = 1;
+        // Taken out under the lock as send_UART_ExtPack_command_coalesced() replaces queued command pairs
+        uint16_t data;
+        while (read_send_buf(&send_buf, &data) == EXT_PACK_SUCCESS) {
+            bytes[amount_bytes++] = (uint8_t)(data >> 8);
+            bytes[amount_bytes++] = (uint8_t)data;
+        }
+        pthread_mutex_unlock(&ExtPack_LL_lock);
+#else
+        while (!next_command_to_send_is_pending) {
+            pthread_cond_wait(&ExtPack_LL_send_cond, &ExtPack_LL_lock);
+        }
+        ExtPack_LL_tx_busy = 1;
+        bytes[amount_bytes++] = (uint8_t)(next_command_to_send >> 8);
+        bytes[amount_bytes++] = (uint8_t)next_command_to_send;
+        pthread_mutex_unlock(&ExtPack_LL_lock);
+#endif
+        uint16_t written = 0;
+        while (written < amount_bytes) {
+            ssize_t ret = write(ExtPack_LL_fd, bytes + written, amount_bytes - written);
+            if (ret < 0) {
+                perror("ExtPack: writing serial device failed");
+                break;
+            }
+            written += ret;
+        }
+        pthread_mutex_lock(&ExtPack_LL_lock);
+#if SEND_BUF_LEN == 0
+        // Sending slot is only free after the command pair is handed over to the device
+        next_command_to_send_is_pending = 0;
+#endif
+        ExtPack_LL_tx_busy = 0;
+        if (ExtPack_LL_tx_complete_notify && is_UART_ExtPack_tx_complete()) {
+            // Replaces the TX complete interrupt
+            ExtPack_LL_tx_complete_notify = 0;
+            process_ExtPack_tx_complete();
+        }
+        pthread_mutex_unlock(&ExtPack_LL_lock);
+    }
+    return NULL;
+}
+
+// --------------------------------------- Receiving ---------------------------------------
+
+/*
+ * Receives data from ExtPack via UART and triggers custom ISRs of Units.
+ * Resets the state machine when the data byte of a command pair does not arrive in time.
+ */
+static void* ExtPack_LL_reader(void* arg) {
+    ExtPack_LL_is_ISR = 1;
+    struct pollfd poll_fd = { .fd = ExtPack_LL_fd, .events = POLLIN };
+    uint8_t bytes[64];
+    while (1) {
+        int timeout_ms = recv_state == RECV_DATA_NEXT_STATE ? EXT_PACK_HOST_RESYNC_TIMEOUT_MS : -1;
+        int ready = poll(&poll_fd, 1, timeout_ms);
+        if (ready == 0) {
+            // Reset state machine
+            recv_state = RECV_UNIT_NEXT_STATE;
+            pthread_mutex_lock(&ExtPack_LL_lock);
+            COUNT_EXT_PACK_LINK_STAT(resyncs);
+            pthread_mutex_unlock(&ExtPack_LL_lock);
+            continue;
+        }
+        if (ready < 0) {
+            continue; // Interrupted by signal
+        }
+        ssize_t amount_bytes = read(ExtPack_LL_fd, bytes, sizeof(bytes));
+        if (amount_bytes <= 0) {
+            if (amount_bytes == 0 || !(poll_fd.revents & POLLIN)) {
+                // Device closed (p.ex. other end of pty) --> Wait for it to come back
+                usleep(1000);
+            }
+            continue;
+        }
+        for (ssize_t i = 0; i < amount_bytes; i++) {
+            if (recv_state == RECV_UNIT_NEXT_STATE) {
+                // Received unit number
+                received_unit = bytes[i];
+                recv_state = RECV_DATA_NEXT_STATE;
+            } else {
+                // Received unit data
+                recv_state = RECV_UNIT_NEXT_STATE;
+                pthread_mutex_lock(&ExtPack_LL_lock);
+                EXT_PACK_PROFILE_START(profile_start);
+                process_received_ExtPack_data(received_unit, bytes[i]);
+                EXT_PACK_PROFILE_END(EXT_PACK_PROFILE_RX_ISR, profile_start);
+                pthread_mutex_unlock(&ExtPack_LL_lock);
+            }
+        }
+    }
+    return NULL;
+}
+
+// ---------------------------------------- Pacing -----------------------------------------
+
+#if EXT_PACK_PACED_JOBS > 0
+void start_ExtPack_LL_pace_timer() {
+    pthread_mutex_lock(&ExtPack_LL_lock);
+    if (!ExtPack_LL_pace_running) {
+        ExtPack_LL_pace_running = 1;
+        pthread_cond_signal(&ExtPack_LL_pace_cond);
+    }
+    pthread_mutex_unlock(&ExtPack_LL_lock);
+}
+
+void stop_ExtPack_LL_pace_timer() {
+    pthread_mutex_lock(&ExtPack_LL_lock);
+    ExtPack_LL_pace_running = 0;
+    pthread_mutex_unlock(&ExtPack_LL_lock);
+}
+
+/*
+ * Calls process_ExtPack_pace_tick every EXT_PACK_PACE_TICK_US while the pace timer is started.
+ */
+static void* ExtPack_LL_pacing(void* arg) {
+    ExtPack_LL_is_ISR = 1;
+    struct timespec next_tick;
+    clock_gettime(CLOCK_MONOTONIC, &next_tick);
+    pthread_mutex_lock(&ExtPack_LL_lock);
+    while (1) {
+        while (!ExtPack_LL_pace_running) {
+            pthread_cond_wait(&ExtPack_LL_pace_cond, &ExtPack_LL_lock);
+            clock_gettime(CLOCK_MONOTONIC, &next_tick);
+        }
+        pthread_mutex_unlock(&ExtPack_LL_lock);
+        // Absolute ticks, so the time spent in the ticks does not stretch the gaps
+        next_tick.tv_nsec += EXT_PACK_PACE_TICK_US * 1000L;
+        if (next_tick.tv_nsec >= 1000000000L) {
+            next_tick.tv_sec++;
+            next_tick.tv_nsec -= 1000000000L;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_tick, NULL);
+        pthread_mutex_lock(&ExtPack_LL_lock);
+        if (ExtPack_LL_pace_running) {
+            EXT_PACK_PROFILE_START(profile_start);
+            process_ExtPack_pace_tick();
+            EXT_PACK_PROFILE_END(EXT_PACK_PROFILE_PACE_ISR, profile_start);
+        }
+    }
+    return NULL;
+}
+#endif
+
+// ---------------------------------------- Timebase ---------------------------------------
+
+#if EXT_PACK_TIMEBASE
+uint32_t get_ExtPack_LL_time_us() {
+    // The clock is read in wait loops --> Yield, so the reader and writer threads run on single core hosts (like _delay_us())
+    sched_yield();
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000ULL + now.tv_nsec / 1000);
+}
+#endif
+
+// ---------------------------------------- Sleeping ---------------------------------------
+
+#if EXT_PACK_SLEEP_WAIT
+void sleep_ExtPack_LL_idle(uint8_t interrupt_state) {
+    if (ExtPack_LL_is_ISR) {
+        return; // Like disabled interrupts --> Nothing would set the event
+    }
+    // No sleep mode --> Release all nested critical zones, so the reader thread is able to set the event
+    uint8_t depth = ExtPack_LL_critical_depth;
+    for (uint8_t i = 0; i < depth; i++) {
+        pthread_mutex_unlock(&ExtPack_LL_lock);
+    }
+    sched_yield();
+    for (uint8_t i = 0; i < depth; i++) {
+        pthread_mutex_lock(&ExtPack_LL_lock);
+    }
+}
+#endif
+
+// ---------------------------------------- Standby ----------------------------------------
+
+#if EXT_PACK_STANDBY
+ext_pack_error_t sleep_ExtPack_LL_standby() {
+    return EXT_PACK_FAILURE; // No wake-up by received frames from a sleep mode stopping the clock
+}
+#endif
+
+// ---------------------------------------- Utility ----------------------------------------
+
+#if EXT_PACK_PROFILING
+uint16_t get_ExtPack_LL_cycles() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint16_t)(((uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec) * (F_CPU / 1000000UL) / 1000);
+}
+#endif
+
+uint8_t enter_critical_zone() {
+    pthread_mutex_lock(&ExtPack_LL_lock);
+    ExtPack_LL_critical_depth++;
+    return 0; // Recursive lock --> Nesting needs no state
+}
+
+void exit_critical_zone(uint8_t interrupt_state) {
+    ExtPack_LL_critical_depth--;
+    pthread_mutex_unlock(&ExtPack_LL_lock);
+}
@@ -1,6 +1,11 @@
 #include "ExtPack_LL.h"
+#include "../Core/ExtPack_Link_Stats_Internal.h"
+#include "../Core/ExtPack_Profiling_Internal.h"
+#include "../Core/ExtPack_Timebase_Internal.h"
+#include "../Core/ExtPack_Standby_Internal.h"
 #include "avr/io.h"
 #include "avr/interrupt.h"
+#include "avr/sleep.h"
 
 /**
  * @def BAUD_CONST
@@ -46,16 +51,30 @@ volatile state_type recv_state = RECV_UNIT_NEXT_STATE;
 #if SEND_BUF_LEN > 0
 #include "../Core/ExtPack_Ringbuffer_Internal.h"
 
-volatile ringbuffer_elem_t send_buf[SEND_BUF_LEN];
-volatile ringbuffer_metadata_t send_buf_metadata;
+DEFINE_RINGBUFFER(send_buf, uint16_t, SEND_BUF_LEN)
+volatile send_buf_t send_buf;
 
 volatile uint8_t next_data_to_send_is_buffer_pair = 1;
 #endif
 
 volatile uint8_t next_data_to_send;
-volatile unit_t received_unit;
 
-volatile uint8_t ExtPack_LL_SREG_save;
+/*
+ * Set while nothing was sent since the last TX complete (also after init) as the TX complete flag is not set then.
+ */
+volatile uint8_t tx_idle = 1;
+volatile unit_t received_unit;
+#if EXT_PACK_STANDBY
+/*
+ * Set by the receive start interrupt waking the controller until the wake-up byte is received
+ */
+volatile uint8_t standby_wakeup = 0;
+volatile uint16_t standby_wakeup_cycles; // Cycle counter at the receive start interrupt
+/*
+ * Clock cycles from the start bit until the stop bit of a frame is sampled (9.5 bit times)
+ */
+#define STANDBY_FRAME_CYCLES ((uint16_t)((19UL * F_CPU) / (2UL * BAUD_RATE)))
+#endif
 
 // ----------------------------------------- Init ------------------------------------------
 
@@ -63,7 +82,7 @@ void init_ExtPack_LL() {
     CPUINT_LVL1VEC = USART0_DRE_vect_num; // Set UART data register empty interrupt to higher priority as receive interrupt (Otherwise sending will be interrupted by receiving which leads to malformed command pairs)
 #if SEND_BUF_LEN > 0
     // ------- Init ringbuffer -------
-    init_ringbuffer_metadata(send_buf, SEND_BUF_LEN, &send_buf_metadata);
+    init_send_buf(&send_buf);
 #endif
     /*
      * ---------- Init UART ----------
@@ -96,28 +115,102 @@ void init_ExtPack_LL() {
     // No compares used --> No change needed
     // Set prescaler to /8
     TCA0.SINGLE.CTRLA |= TCA_SINGLE_CLKSEL_DIV8_gc | TCA_SINGLE_ENABLE_bm;
+#if EXT_PACK_PROFILING || EXT_PACK_TIMEBASE
+    /*
+     * ---------- Init cycle counter ----------
+     * TCB0 free running (periodic interrupt mode) without prescaler
+     * The capture interrupt (every 65536 clock cycles) extends it to the clock of the timebase
+     */
+    TCB0.CCMP = 0xFFFF;
+    TCB0.CTRLA = TCB_CLKSEL_CLKDIV1_gc | TCB_ENABLE_bm;
+#endif
+#if EXT_PACK_TIMEBASE
+    TCB0.INTCTRL = TCB_CAPT_bm;
+#endif
+#if EXT_PACK_PACED_JOBS > 0
+    /*
+     * ---------- Init pace timer ----------
+     * TCB1 in periodic interrupt mode without prescaler
+     * --> Interrupt every EXT_PACK_PACE_TICK_US (100 us = 2000 clock cycles at 20 MHz)
+     * Started by start_ExtPack_LL_pace_timer()
+     * Clock cycles rounded up --> the tick is never shorter than EXT_PACK_PACE_TICK_US
+     */
+    #define PACE_TIMER_CYCLES ((F_CPU * 1ULL * EXT_PACK_PACE_TICK_US + 1000000ULL - 1) / 1000000ULL)
+    #if PACE_TIMER_CYCLES == 0
+        #error EXT_PACK_PACE_TICK_US must not be 0!
+    #elif PACE_TIMER_CYCLES > 65536
+        #error EXT_PACK_PACE_TICK_US too long for the 16 bit TCB1!
+    #endif
+    TCB1.CCMP = PACE_TIMER_CYCLES - 1;
+#endif
     // Enable global interrupt
     sei();
 }
 
 // ---------------------------------------- Sending ----------------------------------------
 
-ext_pack_error_t send_UART_ExtPack_command(unit_t unit, uint8_t data) {
+#if EXT_PACK_PACED_JOBS > 0
+/*
+ * Set while the pace timer runs. Only changed by start_ExtPack_LL_pace_timer() and stop_ExtPack_LL_pace_timer(),
+ * the interrupt enable bit is also cleared while the send buffer is written.
+ */
+volatile uint8_t pace_timer_running = 0;
+#endif
+
 #if SEND_BUF_LEN > 0
+/*
+ * Masks the interrupts of the other producers of the send buffer (RX complete and pace timer interrupt).
+ * Returns the enable bit of the RX complete interrupt for restore_send_producers(),
+ * the pace timer interrupt is restored from pace_timer_running (a stop by the pace ISR is not undone).
+ */
+static inline uint8_t mask_send_producers() {
+    // Interrupts disabled during the read-modify-writes --> The ISRs can not change the bits in between
+    uint8_t interrupt_state = CPU_SREG;
     cli();
-    uint8_t is_first_command = is_buf_empty(&send_buf_metadata);
+    uint8_t producers_enabled = USART0.CTRLA & USART_RXCIE_bm;
+    USART0.CTRLA &= ~USART_RXCIE_bm;
+#if EXT_PACK_PACED_JOBS > 0
+    TCB1.INTCTRL &= ~TCB_CAPT_bm; // Restored if the pace timer is still running
+#endif
+    CPU_SREG = interrupt_state;
+    return producers_enabled;
+}
+
+/*
+ * Activates the data register empty interrupt (deactivated by the ISR when the buffer is empty)
+ * and restores the interrupts masked by mask_send_producers().
+ */
+static inline void restore_send_producers(uint8_t producers_enabled) {
+    uint8_t interrupt_state = CPU_SREG;
+    cli();
+    USART0.CTRLA |= USART_DREIE_bm | (producers_enabled & USART_RXCIE_bm);
+#if EXT_PACK_PACED_JOBS > 0
+    if (pace_timer_running) {
+        TCB1.INTCTRL |= TCB_CAPT_bm;
+    }
+#endif
+    CPU_SREG = interrupt_state;
+}
+#endif
+
+ext_pack_error_t send_UART_ExtPack_command(unit_t unit, uint8_t data) {
+#if SEND_BUF_LEN > 0
+    /*
+     * The ringbuffer is lock-free between this function (producer) and the data register empty ISR (consumer).
+     * Custom ISRs called by the RX complete ISR and the pace timer ISR are the only other producers
+     * --> Only their interrupts are masked, all other interrupts stay enabled.
+     */
+    uint8_t producers_enabled = mask_send_producers();
     // Add to buffer
     uint16_t buf_data = ((uint16_t)unit<<8) | data;
-    uint8_t ret = write_buf(&send_buf_metadata, buf_data);
-    if (is_first_command && ret == EXT_PACK_SUCCESS) {
-        // Activate data register empty interrupt
-        USART0.CTRLA |= USART_DREIE_bm;
-    }
-    sei();
+    uint8_t ret = write_send_buf(&send_buf, buf_data);
+    count_ExtPack_link_send(ret, get_send_buf_used_slots(&send_buf));
+    restore_send_producers(producers_enabled);
     return ret;
 #else
+    // Enter critical zone, the interrupt state is restored afterwards (custom ISRs send with disabled interrupts)
+    uint8_t interrupt_state = CPU_SREG;
     cli();
-    // Enter critical zone
     // Send data if:
     // - UART data register is empty
     // - Data register empty interrupt is not active (so no data is in queue to be sent)
@@ -129,26 +222,142 @@ ext_pack_error_t send_UART_ExtPack_command(unit_t unit, uint8_t data) {
         next_data_to_send = data;
         // Activate data register empty interrupt
         USART0.CTRLA |= USART_DREIE_bm;
-        sei(); // Exit critical zone
+        count_ExtPack_link_send(EXT_PACK_SUCCESS, 1);
+        CPU_SREG = interrupt_state; // Exit critical zone
         return EXT_PACK_SUCCESS;
     } else {
         // Not ready to send data pair
-        sei(); // Exit critical zone
+        count_ExtPack_link_send(EXT_PACK_FAILURE, 0);
+        CPU_SREG = interrupt_state; // Exit critical zone
         return EXT_PACK_FAILURE;
     }
 #endif
 }
 
+uint8_t send_UART_ExtPack_commands(unit_t unit, const uint8_t* data, uint8_t len) {
+#if SEND_BUF_LEN > 0
+    // Same exclusion as send_UART_ExtPack_command, but only once for the whole block
+    uint8_t producers_enabled = mask_send_producers();
+    uint8_t amount_sent = 0;
+    while (amount_sent < len && write_send_buf(&send_buf, ((uint16_t)unit<<8) | data[amount_sent]) == EXT_PACK_SUCCESS) {
+        amount_sent++;
+        count_ExtPack_link_send(EXT_PACK_SUCCESS, get_send_buf_used_slots(&send_buf));
+    }
+    if (amount_sent < len) {
+        count_ExtPack_link_send(EXT_PACK_FAILURE, 0);
+    }
+    restore_send_producers(producers_enabled);
+    return amount_sent;
+#else
+    // Only one command pair fits into the UART
+    return len > 0 && send_UART_ExtPack_command(unit, data[0]) == EXT_PACK_SUCCESS;
+#endif
+}
+
+ext_pack_error_t send_UART_ExtPack_transaction(const ext_pack_command_t* commands, uint8_t amount) {
+#if SEND_BUF_LEN > 0
+    // Same exclusion as send_UART_ExtPack_command --> The free slots can not be taken by another producer
+    uint8_t producers_enabled = mask_send_producers();
+    uint8_t ret = EXT_PACK_FAILURE;
+    if (SEND_BUF_LEN - get_send_buf_used_slots(&send_buf) >= amount) {
+        for (uint8_t i = 0; i < amount; i++) {
+            write_send_buf(&send_buf, ((uint16_t)commands[i].unit<<8) | commands[i].data);
+            count_ExtPack_link_send(EXT_PACK_SUCCESS, get_send_buf_used_slots(&send_buf));
+        }
+        ret = EXT_PACK_SUCCESS;
+    } else {
+        count_ExtPack_link_send(EXT_PACK_FAILURE, 0);
+    }
+    restore_send_producers(producers_enabled);
+    return ret;
+#else
+    // Only one command pair fits into the UART
+    if (amount > 1) {
+        count_ExtPack_link_send(EXT_PACK_FAILURE, 0);
+        return EXT_PACK_FAILURE;
+    }
+    return amount == 0 ? EXT_PACK_SUCCESS : send_UART_ExtPack_command(commands[0].unit, commands[0].data);
+#endif
+}
+
+#if EXT_PACK_TX_COALESCING
+ext_pack_error_t send_UART_ExtPack_command_coalesced(unit_t unit, uint8_t data) {
+#if SEND_BUF_LEN > 0
+    // The data register empty ISR (consumer) is masked too --> No queued command pair is taken out while it is replaced
+    uint8_t producers_enabled = mask_send_producers();
+    uint8_t interrupt_state = CPU_SREG;
+    cli(); // The TX complete ISR changes CTRLA too
+    USART0.CTRLA &= ~USART_DREIE_bm;
+    CPU_SREG = interrupt_state;
+    // Only the newest queued command pair --> No command pair of another unit is overtaken by the new data
+    if (get_send_buf_used_slots(&send_buf) > 0) {
+        volatile uint16_t* queued = peek_send_buf(&send_buf, 0);
+        if ((uint8_t)(*queued >> 8) == unit) {
+            *queued = ((uint16_t)unit<<8) | data;
+            COUNT_EXT_PACK_LINK_STAT(tx_coalesced);
+            restore_send_producers(producers_enabled);
+            return EXT_PACK_SUCCESS;
+        }
+    }
+    uint8_t ret = write_send_buf(&send_buf, ((uint16_t)unit<<8) | data);
+    count_ExtPack_link_send(ret, get_send_buf_used_slots(&send_buf));
+    restore_send_producers(producers_enabled); // Also activates the data register empty interrupt again
+    return ret;
+#else
+    // Nothing is queued without send buffer
+    return send_UART_ExtPack_command(unit, data);
+#endif
+}
+#endif
+
+uint8_t get_UART_ExtPack_tx_capacity() {
+    return SEND_BUF_LEN > 0 ? SEND_BUF_LEN : 1;
+}
+
+uint8_t get_UART_ExtPack_free_slots() {
+#if SEND_BUF_LEN > 0
+    return SEND_BUF_LEN - get_send_buf_used_slots(&send_buf);
+#else
+    return (USART0.STATUS & USART_DREIF_bm) && !(USART0.CTRLA & USART_DREIE_bm);
+#endif
+}
+
+uint8_t is_UART_ExtPack_tx_complete() {
+    return !(USART0.CTRLA & USART_DREIE_bm) && (tx_idle || (USART0.STATUS & USART_TXCIF_bm));
+}
+
+void notify_UART_ExtPack_tx_complete() {
+    // Interrupts disabled during the read-modify-write --> The USART ISRs can not change CTRLA in between
+    uint8_t interrupt_state = CPU_SREG;
+    cli();
+    USART0.CTRLA |= USART_TXCIE_bm;
+    CPU_SREG = interrupt_state;
+}
+
+/*
+ * Calls process_ExtPack_tx_complete once when all command pairs are sent (enabled by notify_UART_ExtPack_tx_complete)
+ */
+ISR(USART0_TXC_vect) {
+    USART0.STATUS = USART_TXCIF_bm; // Not cleared by hardware
+    if (USART0.CTRLA & USART_DREIE_bm) {
+        return; // Flag of a gap between two sends --> Wait for the end of the running send
+    }
+    tx_idle = 1; // TX complete flag is cleared now
+    USART0.CTRLA &= ~USART_TXCIE_bm;
+    process_ExtPack_tx_complete();
+}
+
 /*
  * Sends next buffer data pair or second part of data pair
  */
 ISR(USART0_DRE_vect) {
+    EXT_PACK_PROFILE_START(profile_start);
 #if SEND_BUF_LEN > 0
     // UART data register empty
     if(next_data_to_send_is_buffer_pair) {
         // Send buffer data
         uint16_t data;
-        if(read_buf(&send_buf_metadata, &data) == EXT_PACK_SUCCESS) {
+        if(read_send_buf(&send_buf, &data) == EXT_PACK_SUCCESS) {
             USART0.TXDATAL = (uint8_t)(data >> 8);
             next_data_to_send = (uint8_t)data;
             next_data_to_send_is_buffer_pair = 0;
@@ -161,9 +370,12 @@ ISR(USART0_DRE_vect) {
         // Send data part of message
         USART0.TXDATAL = next_data_to_send;
         // Check if command in buffer needs to be sent
-        if (is_buf_empty(&send_buf_metadata)) {
+        if (is_send_buf_empty(&send_buf)) {
             // Deactivate data register empty interrupt as no data in queue
             USART0.CTRLA &= ~USART_DREIE_bm;
+            // Last byte --> TX complete flag is set again when it left the shift register
+            USART0.STATUS = USART_TXCIF_bm;
+            tx_idle = 0;
         }
     }
 #else
@@ -171,7 +383,11 @@ ISR(USART0_DRE_vect) {
     USART0.TXDATAL = next_data_to_send;
     // Deactivate data register empty interrupt
     USART0.CTRLA &= ~USART_DREIE_bm;
+    // TX complete flag is set again when the data byte left the shift register
+    USART0.STATUS = USART_TXCIF_bm;
+    tx_idle = 0;
 #endif
+    EXT_PACK_PROFILE_END(EXT_PACK_PROFILE_DRE_ISR, profile_start);
 }
 
 // --------------------------------------- Receiving ---------------------------------------
@@ -181,8 +397,38 @@ ISR(USART0_DRE_vect) {
  * Also manages received data for units.
  */
 ISR(USART0_RXC_vect) {
+#if EXT_PACK_STANDBY
+    if (USART0.STATUS & USART_RXSIF_bm) {
+        // Receive start interrupt (same vector) --> Start bit woke the controller from standby
+#if EXT_PACK_PROFILING || EXT_PACK_TIMEBASE
+        standby_wakeup_cycles = TCB0.CNT;
+#endif
+        USART0.STATUS = USART_RXSIF_bm;
+        USART0.CTRLA &= ~USART_RXSIE_bm;
+        standby_wakeup = 1;
+        if (!(USART0.STATUS & USART_RXCIF_bm)) {
+            return; // Wake-up byte still being received
+        }
+    }
+#endif
+    EXT_PACK_PROFILE_START(profile_start);
     uint8_t errors = USART0.RXDATAH;
     uint8_t received_data = USART0.RXDATAL;
+    count_ExtPack_link_receive_errors(errors & USART_FERR_bm, errors & USART_PERR_bm, errors & USART_BUFOVF_bm);
+#if EXT_PACK_STANDBY
+    if (standby_wakeup) {
+        standby_wakeup = 0;
+        uint16_t wake_cycles = 0;
+#if EXT_PACK_PROFILING || EXT_PACK_TIMEBASE
+        // Latency = frame time (until the stop bit is sampled) - time since the receive start interrupt
+        uint16_t receive_cycles = TCB0.CNT - standby_wakeup_cycles;
+        if (receive_cycles < STANDBY_FRAME_CYCLES) {
+            wake_cycles = STANDBY_FRAME_CYCLES - receive_cycles;
+        }
+#endif
+        count_ExtPack_wakeup(errors & (USART_FERR_bm | USART_PERR_bm | USART_BUFOVF_bm), wake_cycles);
+    }
+#endif
     if(recv_state == RECV_UNIT_NEXT_STATE) {
         // Received unit number
         received_unit = received_data;
@@ -213,25 +459,160 @@ ISR(USART0_RXC_vect) {
         // Disables state machine reset timer
         TCA0.SINGLE.INTCTRL &= ~TCA_SINGLE_OVF_bm;
     }
+    EXT_PACK_PROFILE_END(EXT_PACK_PROFILE_RX_ISR, profile_start);
 }
 
 /*
  * Resets state machine when timer/counter0 has an overflow
  */
 ISR(TCA0_OVF_vect) {
+    EXT_PACK_PROFILE_START(profile_start);
     //Reset state machine
+    COUNT_EXT_PACK_LINK_STAT(resyncs);
     recv_state = RECV_UNIT_NEXT_STATE;
     // Disables timer interrupts
     TCA0.SINGLE.INTCTRL &= ~TCA_SINGLE_OVF_bm;
+    EXT_PACK_PROFILE_END(EXT_PACK_PROFILE_RESYNC_ISR, profile_start);
 }
 
+// ---------------------------------------- Pacing -----------------------------------------
+
+#if EXT_PACK_PACED_JOBS > 0
+void start_ExtPack_LL_pace_timer() {
+    if (pace_timer_running) {
+        return; // Already running
+    }
+    pace_timer_running = 1;
+    TCB1.CNT = 0;
+    TCB1.INTFLAGS = TCB_CAPT_bm; // Reset interrupt flag
+    TCB1.INTCTRL = TCB_CAPT_bm;
+    TCB1.CTRLA = TCB_CLKSEL_CLKDIV1_gc | TCB_ENABLE_bm;
+}
+
+void stop_ExtPack_LL_pace_timer() {
+    TCB1.CTRLA = 0;
+    TCB1.INTCTRL = 0;
+    pace_timer_running = 0;
+}
+
+/*
+ * Feeds the running paced sends into the send buffer
+ */
+ISR(TCB1_INT_vect) {
+    EXT_PACK_PROFILE_START(profile_start);
+    TCB1.INTFLAGS = TCB_CAPT_bm; // Not cleared by hardware
+    process_ExtPack_pace_tick();
+    EXT_PACK_PROFILE_END(EXT_PACK_PROFILE_PACE_ISR, profile_start);
+}
+#endif
+
+// ---------------------------------------- Timebase ---------------------------------------
+
+#if EXT_PACK_TIMEBASE
+/*
+ * Microseconds and remaining fraction of a microsecond (in 1 / EXT_PACK_TIMEBASE_CYCLES_DEN us) of all cycle counter overflows
+ */
+volatile uint32_t time_overflow_us = 0;
+volatile uint32_t time_overflow_rest = 0;
+
+/*
+ * Adds the 65536 clock cycles of an overflow (constants --> no division at runtime)
+ */
+static inline void add_time_overflow() {
+    time_overflow_us += EXT_PACK_TIMEBASE_OVERFLOW_US;
+    time_overflow_rest += EXT_PACK_TIMEBASE_OVERFLOW_REST;
+    if (time_overflow_rest >= EXT_PACK_TIMEBASE_CYCLES_DEN) {
+        time_overflow_us++;
+        time_overflow_rest -= EXT_PACK_TIMEBASE_CYCLES_DEN;
+    }
+}
+
+uint32_t get_ExtPack_LL_time_us() {
+    uint8_t interrupt_state = enter_critical_zone();
+    uint16_t cycles = TCB0.CNT;
+    if (TCB0.INTFLAGS & TCB_CAPT_bm) {
+        // Overflow not handled by the ISR yet (interrupts disabled) --> Handle it here
+        TCB0.INTFLAGS = TCB_CAPT_bm;
+        add_time_overflow();
+        cycles = TCB0.CNT;
+    }
+    uint32_t time_us = time_overflow_us
+        + (uint32_t)((time_overflow_rest + (ext_pack_timebase_calc_t)cycles * EXT_PACK_TIMEBASE_US_NUM) / EXT_PACK_TIMEBASE_CYCLES_DEN);
+    exit_critical_zone(interrupt_state);
+    return time_us;
+}
+
+/*
+ * Extends the cycle counter to the microsecond clock
+ */
+ISR(TCB0_INT_vect) {
+    add_time_overflow();
+}
+#endif
+
+// ---------------------------------------- Sleeping ---------------------------------------
+
+#if EXT_PACK_SLEEP_WAIT
+void sleep_ExtPack_LL_idle(uint8_t interrupt_state) {
+    if (!(interrupt_state & CPU_I_bm)) {
+        return; // Interrupts disabled by the caller --> Nothing would wake the controller
+    }
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sei(); // The instruction after sei() is executed before any interrupt --> No interrupt is missed before sleeping
+    sleep_cpu();
+    sleep_disable();
+    cli(); // Back in the critical zone
+}
+#endif
+
+// ---------------------------------------- Standby ----------------------------------------
+
+#if EXT_PACK_STANDBY
+ext_pack_error_t sleep_ExtPack_LL_standby() {
+    uint8_t interrupt_state = enter_critical_zone();
+    if (!(interrupt_state & CPU_I_bm) || recv_state != RECV_UNIT_NEXT_STATE || !is_UART_ExtPack_tx_complete()
+#if EXT_PACK_PACED_JOBS > 0
+        || pace_timer_running // Paced send running
+#endif
+        ) {
+        exit_critical_zone(interrupt_state);
+        return EXT_PACK_FAILURE;
+    }
+    // Start-of-frame detection starts the oscillator on the start bit, the receive start interrupt wakes the CPU
+    standby_wakeup = 0;
+    USART0.STATUS = USART_RXSIF_bm;
+    USART0.CTRLB |= USART_SFDEN_bm;
+    USART0.CTRLA |= USART_RXSIE_bm;
+    count_ExtPack_standby_entry();
+    set_sleep_mode(SLEEP_MODE_STANDBY);
+    sleep_enable();
+    sei(); // The instruction after sei() is executed before any interrupt --> No interrupt is missed before sleeping
+    sleep_cpu();
+    sleep_disable();
+    cli();
+    // Woken by another interrupt --> Bytes received while awake must not count as wake-ups
+    USART0.CTRLA &= ~USART_RXSIE_bm;
+    USART0.CTRLB &= ~USART_SFDEN_bm;
+    exit_critical_zone(interrupt_state);
+    return EXT_PACK_SUCCESS;
+}
+#endif
+
 // ---------------------------------------- Utility ----------------------------------------
 
-void enter_critical_zone() {
-    ExtPack_LL_SREG_save = CPU_SREG;
+#if EXT_PACK_PROFILING
+uint16_t get_ExtPack_LL_cycles() {
+    return TCB0.CNT;
+}
+#endif
+
+uint8_t enter_critical_zone() {
+    uint8_t interrupt_state = CPU_SREG;
     cli();
+    return interrupt_state;
 }
 
-void exit_critical_zone() {
-    CPU_SREG = ExtPack_LL_SREG_save;
+void exit_critical_zone(uint8_t interrupt_state) {
+    CPU_SREG = interrupt_state;
 }
\ No newline at end of file
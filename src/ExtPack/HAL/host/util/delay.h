@@ -0,0 +1,50 @@
+/**
+ * @file delay.h
+ *
+ * @brief Host replacement of the avr-libc busy-wait delay functions.
+ *
+ * @layer HAL
+ *
+ * @details Only on the include path when building for the host (MCU_AVR_GCC=host).
+ * Busy waits on the monotonic clock as sleeping the thread would take far longer than 1 us.
+ * The processor is yielded while waiting so the reader and writer threads of the HAL can run on single core hosts.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_HOST_UTIL_DELAY_H
+#define EXTPACK_HOST_UTIL_DELAY_H
+
+#include <sched.h>
+#include <time.h>
+
+/**
+ * @brief Busy waits for the given time in us.
+ *
+ * @layer HAL
+ *
+ * @param __us Delay time in us.
+ */
+static inline void _delay_us(double __us) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    long long end_ns = now.tv_sec * 1000000000LL + now.tv_nsec + (long long)(__us * 1000.0);
+    do {
+        sched_yield();
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    } while (now.tv_sec * 1000000000LL + now.tv_nsec < end_ns);
+}
+
+/**
+ * @brief Busy waits for the given time in ms.
+ *
+ * @layer HAL
+ *
+ * @param __ms Delay time in ms.
+ */
+static inline void _delay_ms(double __ms) {
+    _delay_us(__ms * 1000.0);
+}
+
+#endif //EXTPACK_HOST_UTIL_DELAY_H
@@ -1,13 +1,145 @@
 #include "ExtPack_Advanced.h"
-#include "../Util/Dynamic_Delay.h"
+#include "../Core/ExtPack_Timebase.h"
 
 ext_pack_error_t send_String_to_ExtPack(unit_t unit, const uint8_t* data, uint16_t send_byte_delay_us) {
     int index = 0;
+    ext_pack_deadline_t deadline = get_ExtPack_deadline(0);
     while (data[index] != '\0') {
+        while (!is_ExtPack_deadline_expired(&deadline)); // Delay since the send of the previous byte
         if(_send_to_ExtPack(unit, data[index++]) == EXT_PACK_FAILURE) {
             return EXT_PACK_FAILURE;
         }
-        delay_us(send_byte_delay_us);
+        deadline = get_ExtPack_deadline(send_byte_delay_us);
     }
     return EXT_PACK_SUCCESS;
-}
\ No newline at end of file
+}
+
+ext_pack_error_t send_buffer_to_ExtPack(unit_t unit, const uint8_t* buf, uint16_t len, uint16_t timeout_us) {
+    if ((unit & 0b00111111) >= USED_UNITS) {
+        return EXT_PACK_FAILURE;
+    }
+    ext_pack_deadline_t deadline = get_ExtPack_deadline(timeout_us);
+    while (len > 0) {
+        uint8_t amount_sent = _send_block_to_ExtPack(unit, buf, len > 0xFF ? 0xFF : (uint8_t)len);
+        if (amount_sent > 0) {
+            buf += amount_sent;
+            len -= amount_sent;
+            deadline = get_ExtPack_deadline(timeout_us); // Timeout restarts with every progress
+        } else if (is_ExtPack_deadline_expired(&deadline)) { // Wait for space in the send buffer
+            // Timeout exceeded
+            return EXT_PACK_FAILURE;
+        }
+    }
+    return EXT_PACK_SUCCESS;
+}
+
+ext_pack_error_t wait_ExtPack_tx_space(uint8_t amount, uint16_t timeout_us) {
+    ext_pack_deadline_t deadline = get_ExtPack_deadline(timeout_us);
+    while (get_ExtPack_tx_free_slots() < amount) {
+        if (is_ExtPack_deadline_expired(&deadline)) {
+            // Timeout exceeded
+            return EXT_PACK_FAILURE;
+        }
+    }
+    return EXT_PACK_SUCCESS;
+}
+
+ext_pack_error_t flush_ExtPack_tx(uint16_t timeout_us) {
+    ext_pack_deadline_t deadline = get_ExtPack_deadline(timeout_us);
+    while (!is_ExtPack_tx_complete()) {
+        if (is_ExtPack_deadline_expired(&deadline)) {
+            // Timeout exceeded
+            return EXT_PACK_FAILURE;
+        }
+    }
+    return EXT_PACK_SUCCESS;
+}
+
+ext_pack_error_t send_transaction_to_ExtPack(const ext_pack_command_t* commands, uint8_t amount, uint16_t command_timeout_us) {
+    if (amount > get_ExtPack_tx_capacity()) {
+        // Never fits at once --> Command by command
+        for (uint8_t i = 0; i < amount; i++) {
+            if (wait_ExtPack_tx_space(1, command_timeout_us) == EXT_PACK_FAILURE || _send_to_ExtPack(commands[i].unit, commands[i].data) == EXT_PACK_FAILURE) {
+                return EXT_PACK_FAILURE;
+            }
+        }
+        return EXT_PACK_SUCCESS;
+    }
+    uint32_t timeout_us = (uint32_t)command_timeout_us * amount;
+    if (wait_ExtPack_tx_space(amount, timeout_us > UINT16_MAX ? UINT16_MAX : (uint16_t)timeout_us) == EXT_PACK_FAILURE) {
+        return EXT_PACK_FAILURE;
+    }
+    // Only fails if a custom ISR took the free slots in the meantime or a unit is not used
+    return _send_transaction_to_ExtPack(commands, amount);
+}
+
+ext_pack_error_t send_configured_command_to_ExtPack(ext_pack_command_t configuration, ext_pack_command_t command, uint16_t command_timeout_us) {
+    if (get_ExtPack_tx_capacity() < 2) {
+        // Only one command fits at once --> One by one
+        if (wait_ExtPack_tx_space(1, command_timeout_us) == EXT_PACK_FAILURE
+            || _send_configuration_to_ExtPack(configuration.unit, configuration.data) == EXT_PACK_FAILURE
+            || wait_ExtPack_tx_space(1, command_timeout_us) == EXT_PACK_FAILURE) {
+            return EXT_PACK_FAILURE;
+        }
+        return _send_to_ExtPack(command.unit, command.data);
+    }
+    uint32_t timeout_us = (uint32_t)command_timeout_us * 2;
+    if (wait_ExtPack_tx_space(2, timeout_us > UINT16_MAX ? UINT16_MAX : (uint16_t)timeout_us) == EXT_PACK_FAILURE) {
+        return EXT_PACK_FAILURE;
+    }
+    const ext_pack_command_t commands[] = { configuration, command };
+    ext_pack_error_t ret;
+    uint8_t interrupt_state = enter_critical_zone();
+    if (_is_ExtPack_configuration_current(configuration.unit, configuration.data)) {
+        ret = _send_to_ExtPack(command.unit, command.data);
+    } else {
+        ret = _send_transaction_to_ExtPack(commands, 2);
+        if (ret == EXT_PACK_SUCCESS) {
+            _update_ExtPack_configuration(configuration.unit, configuration.data);
+        }
+    }
+    exit_critical_zone(interrupt_state);
+    return ret;
+}
+
+ext_pack_error_t restore_ExtPack_configuration(uint16_t command_timeout_us) {
+#if EXT_PACK_SHADOW_STATE
+    ext_pack_command_t commands[EXT_PACK_MAX_RESTORE_COMMANDS];
+    for (unit_t unit = 0; unit < USED_UNITS; unit++) {
+        uint8_t amount = _get_ExtPack_lost_configuration(unit, commands);
+        if (amount == 0) {
+            continue;
+        }
+        if (amount > get_ExtPack_tx_capacity()) {
+            // Never fits at once --> Command by command
+            if (send_transaction_to_ExtPack(commands, amount, command_timeout_us) == EXT_PACK_FAILURE) {
+                return EXT_PACK_FAILURE;
+            }
+            uint8_t interrupt_state = enter_critical_zone();
+            _set_ExtPack_configuration_restored(unit);
+            exit_critical_zone(interrupt_state);
+            continue;
+        }
+        uint32_t timeout_us = (uint32_t)command_timeout_us * amount;
+        if (wait_ExtPack_tx_space(amount, timeout_us > UINT16_MAX ? UINT16_MAX : (uint16_t)timeout_us) == EXT_PACK_FAILURE) {
+            return EXT_PACK_FAILURE;
+        }
+        ext_pack_error_t ret = EXT_PACK_SUCCESS;
+        uint8_t interrupt_state = enter_critical_zone();
+        amount = _get_ExtPack_lost_configuration(unit, commands); // Custom ISRs may have sent a part in the meantime
+        if (amount > 0) {
+            ret = _send_transaction_to_ExtPack(commands, amount);
+        }
+        if (ret == EXT_PACK_SUCCESS) {
+            _set_ExtPack_configuration_restored(unit);
+        }
+        exit_critical_zone(interrupt_state);
+        if (ret == EXT_PACK_FAILURE) {
+            return EXT_PACK_FAILURE;
+        }
+    }
+    return EXT_PACK_SUCCESS;
+#else
+    return EXT_PACK_FAILURE;
+#endif
+}
@@ -6,10 +6,17 @@
  * @layer Service
  *
  * @details This header provides higher-level helper functions for ExtPack units,
- * including utilities to send strings over ExtPack with defined byte delays.
+ * including utilities to send strings over ExtPack with defined byte delays and binary buffers at full link rate
+ * and to wait for the send buffer instead of delaying for an estimated send duration.
  *
  * ## Provided Functions:
  * - send_String_to_ExtPack: Send null-terminated strings with a specified delay between bytes.
+ * - send_buffer_to_ExtPack: Send a buffer with given length (may contain '\0') as fast as the send buffer allows.
+ * - wait_ExtPack_tx_space: Wait until the given amount of command pairs fits into the send buffer.
+ * - flush_ExtPack_tx: Wait until all command pairs are sent.
+ * - send_transaction_to_ExtPack: Send a sequence of commands without commands of custom ISRs in between.
+ * - send_configured_command_to_ExtPack: Send a command after its configuration, skipping the configuration if the ExtPack already has it.
+ * - restore_ExtPack_configuration: Send the configuration of all units again after a reset of the ExtPack.
  *
  * @author Markus Remy
  * @date 04.08.2025
@@ -28,9 +35,97 @@
  *
  * @param unit The ExtPack unit to which the data should be sent. Including the correct set access mode for sending.
  * @param data The data to be sent as String with terminating '\0'.
- * @param send_byte_delay_us The delay between sending two bytes in us.
+ * @param send_byte_delay_us The delay between sending two bytes in us (a deadline from the send of the previous byte, no delay after the last byte).
  * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE if the function was aborted when sending an uint8_t because of an error while sending.
  */
 ext_pack_error_t send_String_to_ExtPack(unit_t unit, const uint8_t* data, uint16_t send_byte_delay_us);
 
+/**
+ * @brief Sends len bytes of the given buffer to ExtPack.
+ * The bytes are added to the send buffer in blocks as soon as space is available.
+ *
+ * @layer Service
+ *
+ * @details Unlike send_String_to_ExtPack() the buffer may contain '\0' and no delay between the bytes is needed.
+ * If no byte could be added to the send buffer for timeout_us, the function aborts and returns an error.
+ *
+ * @param unit The ExtPack unit to which the data should be sent. Including the correct set access mode for sending.
+ * @param buf The data to be sent.
+ * @param len The amount of bytes to send.
+ * @param timeout_us The maximum time in us to wait for space in the send buffer (without progress).
+ * @return EXT_PACK_SUCCESS if all bytes were sent, EXT_PACK_FAILURE if the unit is not used or on timeout.
+ */
+ext_pack_error_t send_buffer_to_ExtPack(unit_t unit, const uint8_t* buf, uint16_t len, uint16_t timeout_us);
+
+/**
+ * @brief Waits until the given amount of command pairs can be sent without failing.
+ *
+ * @layer Service
+ *
+ * @details Returns immediately if there is enough space. Use it between dependent commands instead of delaying
+ * for get_ExtPack_send_duration_us() (only needed without send buffer as the order is kept by the send buffer).
+ *
+ * @param amount The amount of command pairs to send next (at most the size of the send buffer, 1 without send buffer).
+ * @param timeout_us The maximum time in us to wait.
+ * @return EXT_PACK_SUCCESS if the command pairs fit, EXT_PACK_FAILURE on timeout.
+ */
+ext_pack_error_t wait_ExtPack_tx_space(uint8_t amount, uint16_t timeout_us);
+
+/**
+ * @brief Waits until all command pairs are sent completely (see is_ExtPack_tx_complete()).
+ *
+ * @layer Service
+ *
+ * @param timeout_us The maximum time in us to wait.
+ * @return EXT_PACK_SUCCESS if all command pairs are sent, EXT_PACK_FAILURE on timeout.
+ */
+ext_pack_error_t flush_ExtPack_tx(uint16_t timeout_us);
+
+/**
+ * @brief Waits until all commands fit into the send buffer and sends them as one transaction.
+ *
+ * @layer Service
+ *
+ * @details Commands sent by custom ISRs can not get in between (see _send_transaction_to_ExtPack()).
+ * Sequences longer than get_ExtPack_tx_capacity() (p.ex. without send buffer) are sent command by command
+ * and are not protected against commands of custom ISRs.
+ *
+ * @param commands The commands to send.
+ * @param amount The amount of commands.
+ * @param command_timeout_us The maximum time in us to wait for space in the send buffer per command (at most 65535 us in total).
+ * @return EXT_PACK_SUCCESS if all commands were sent, EXT_PACK_FAILURE on timeout or if a unit is not used.
+ */
+ext_pack_error_t send_transaction_to_ExtPack(const ext_pack_command_t* commands, uint8_t amount, uint16_t command_timeout_us);
+
+/**
+ * @brief Sends a command together with the configuration it depends on (p.ex. SPI slave id and data) as one transaction.
+ *
+ * @layer Service
+ *
+ * @details With EXT_PACK_SHADOW_STATE = 1 only the command is sent if the ExtPack already has the configuration
+ * (see _send_configuration_to_ExtPack()). Checking and queueing is done at once, so custom ISRs can not change the configuration in between.
+ * Without send buffer the configuration and the command are sent one by one.
+ *
+ * @param configuration The configuration the command depends on.
+ * @param command The command to send.
+ * @param command_timeout_us The maximum time in us to wait for space in the send buffer per command.
+ * @return EXT_PACK_SUCCESS if the command was sent, EXT_PACK_FAILURE on timeout or if a unit is not used.
+ */
+ext_pack_error_t send_configured_command_to_ExtPack(ext_pack_command_t configuration, ext_pack_command_t command, uint16_t command_timeout_us);
+
+/**
+ * @brief Sends the configuration the ExtPack lost by a reset again (GPIO outputs, SPI slave, I2C partner, timers, ACK enable).
+ *
+ * @layer Service
+ *
+ * @details Needs EXT_PACK_SHADOW_STATE = 1. Every configuration sent since init_ExtPack() and invalidated since
+ * (reset message of the ExtPack, reset_ExtPack() or invalidate_ExtPack_configuration()) is sent with its last value.
+ * The configuration of each unit is one transaction with the enable last, timers are restarted before.
+ * Call it from the main context after the reset was reported (p.ex. reset event), not from the custom ISR of the reset unit.
+ *
+ * @param command_timeout_us The maximum time in us to wait for space in the send buffer per command.
+ * @return EXT_PACK_SUCCESS if the configuration of all units was sent, EXT_PACK_FAILURE on timeout or with EXT_PACK_SHADOW_STATE = 0.
+ */
+ext_pack_error_t restore_ExtPack_configuration(uint16_t command_timeout_us);
+
 #endif //EXTPACK_ADVANCED_H
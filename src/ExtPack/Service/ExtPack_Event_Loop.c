@@ -0,0 +1,54 @@
+#include "ExtPack_Event_Loop.h"
+#include "../Core/ExtPack_Internal.h"
+#include "../Core/ExtPack_Events_Internal.h"
+#include <stddef.h>
+
+ext_pack_event_handler_t event_handlers[USED_UNITS] = {0};
+
+/*
+ * Units with a handler per priority as bitmap (same layout as the event bitmap).
+ */
+uint8_t priority_units[EXT_PACK_EVENT_PRIORITIES][EXT_PACK_EVENT_BYTES] = {0};
+
+ext_pack_error_t set_ExtPack_event_handler(unit_t unit, ext_pack_event_handler_t handler, uint8_t priority) {
+    if (unit >= USED_UNITS || priority >= EXT_PACK_EVENT_PRIORITIES) {
+        return EXT_PACK_FAILURE;
+    }
+    uint8_t index = unit >> 3;
+    uint8_t mask = ExtPack_event_masks[unit & 0x07];
+    for (uint8_t i = 0; i < EXT_PACK_EVENT_PRIORITIES; i++) {
+        priority_units[i][index] &= ~mask;
+    }
+    event_handlers[unit] = handler;
+    if (handler != NULL) {
+        priority_units[priority][index] |= mask;
+    }
+    return EXT_PACK_SUCCESS;
+}
+
+/*
+ * Returns the unit with a handler and a pending event with the highest priority.
+ */
+static unit_t get_next_handled_event() {
+    for (uint8_t priority = 0; priority < EXT_PACK_EVENT_PRIORITIES; priority++) {
+        unit_t unit = get_next_ExtPack_event_of(priority_units[priority]);
+        if (unit != EXT_PACK_NO_EVENT) {
+            return unit;
+        }
+    }
+    return EXT_PACK_NO_EVENT;
+}
+
+uint8_t run_ExtPack_events(uint8_t budget) {
+    uint8_t called = 0;
+    while (called < budget) {
+        unit_t unit = get_next_handled_event();
+        if (unit == EXT_PACK_NO_EVENT) {
+            break;
+        }
+        clear_ExtPack_event(unit);
+        event_handlers[unit](unit, get_ExtPack_stored_unit_input_values(unit));
+        called++;
+    }
+    return called;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file ExtPack_Event_Loop.h
+ *
+ * @brief Main loop event dispatcher for the ExtPack library.
+ *
+ * @layer Service
+ *
+ * @details Instead of polling the event of every unit, handlers are registered per unit with a priority.
+ * run_ExtPack_events() called in the main loop clears the pending events and calls the handlers
+ * with the last received data of the unit, highest priority (0) first and the lowest unit first within one priority.
+ * After every handler the search starts again at the highest priority.
+ *
+ * Events of units without handler are not touched and can still be polled with get_ExtPack_event().
+ *
+ * @note Do not register handlers for units whose events are waited for by other functions
+ * (p.ex. the ACK unit with wait_for_ExtPack_ACK() or SRAM units with read_ExtPack_SRAM_data_from_address()).
+ *
+ * ## Provided Functions:
+ * - set_ExtPack_event_handler: Registers or removes the event handler of a unit.
+ * - run_ExtPack_events: Calls the handlers of pending events.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_EVENT_LOOP_H
+#define EXTPACK_EVENT_LOOP_H
+
+#include "../Core/ExtPack.h"
+
+/**
+ * @typedef ext_pack_event_handler_t
+ * @brief Handler called in the main context for a pending event with the unit and its last received data.
+ */
+typedef void (*ext_pack_event_handler_t)(unit_t unit, uint8_t data);
+
+/**
+ * @brief Registers the event handler of the given unit.
+ *
+ * @layer Service
+ *
+ * @note Use 'NULL' or 'nullptr' to remove the handler.
+ *
+ * @param unit The ExtPack unit.
+ * @param handler The handler to call for events of the unit.
+ * @param priority The priority of the handler (0 is the highest, p.ex. for the Reset and Error units).
+ * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE if the unit is not used or the priority is not below EXT_PACK_EVENT_PRIORITIES.
+ */
+ext_pack_error_t set_ExtPack_event_handler(unit_t unit, ext_pack_event_handler_t handler, uint8_t priority);
+
+/**
+ * @brief Calls the handlers of pending events in priority order.
+ *
+ * @layer Service
+ *
+ * @details The event is cleared before its handler is called.
+ * If new data of the unit is received during the handler, the event is pending again.
+ *
+ * @warning Do not call it from a custom ISR or another ISR.
+ *
+ * @param budget The maximum amount of handlers to call.
+ * @return The amount of called handlers.
+ */
+uint8_t run_ExtPack_events(uint8_t budget);
+
+#endif //EXTPACK_EVENT_LOOP_H
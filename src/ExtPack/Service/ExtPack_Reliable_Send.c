@@ -0,0 +1,278 @@
+#include "ExtPack_Reliable_Send.h"
+#include "ExtPack_U_Acknowledge_Advanced.h"
+#include "../Core/ExtPack_Internal.h"
+#include "../Core/ExtPack_Timebase.h"
+#include <stddef.h>
+
+/**
+ * @def RELIABLE_QUEUED
+ * @brief State of a command waiting to be sent (again).
+ */
+#define RELIABLE_QUEUED 0
+
+/**
+ * @def RELIABLE_SENT
+ * @brief State of a command in flight (waiting for its ACK).
+ */
+#define RELIABLE_SENT 1
+
+/**
+ * @def RELIABLE_ACKED
+ * @brief State of an acknowledged command waiting for its completion callback.
+ */
+#define RELIABLE_ACKED 2
+
+/**
+ * @def RELIABLE_FAILED
+ * @brief State of a command failed after max_tries sends waiting for its completion callback.
+ */
+#define RELIABLE_FAILED 3
+
+/*
+ * A queued command. The state of a sent command is changed by process_ExtPack_reliable_ack().
+ */
+typedef struct {
+    unit_t unit;
+    uint8_t data;
+    uint8_t state;
+    uint8_t tries;                  // Amount of sends
+    uint16_t sequence;              // Send order of the commands in flight (16 bit: at most 65535 us / 20 us per command pair are sent during an ACK timeout)
+    uint16_t timeout_us;            // ACK timeout of the last send
+    ext_pack_deadline_t deadline;   // End of the ACK timeout of the last send
+} reliable_slot_t;
+
+#if EXT_PACK_RELIABLE_WINDOW > 0
+_Static_assert(EXT_PACK_RELIABLE_WINDOW <= 255, "EXT_PACK_RELIABLE_WINDOW has to be between 0 and 255!");
+
+/*
+ * Queued commands as ringbuffer, the oldest command at reliable_head.
+ */
+volatile reliable_slot_t reliable_slots[EXT_PACK_RELIABLE_WINDOW];
+volatile uint8_t reliable_head = 0;
+volatile uint8_t reliable_amount = 0;
+
+static uint8_t reliable_window = 1;
+static uint16_t reliable_timeout_us = 0; // 0: Adaptive timeout of the unit type
+static uint8_t reliable_max_tries = 1;
+static ext_pack_reliable_callback_t reliable_callback = NULL;
+static uint16_t next_reliable_sequence = 0;
+#endif
+
+volatile ext_pack_reliable_stats_t reliable_stats = {0};
+
+#if EXT_PACK_RELIABLE_WINDOW > 0
+/*
+ * Returns the index-th oldest queued command.
+ */
+static inline volatile reliable_slot_t* get_reliable_slot(uint8_t index) {
+    uint8_t slot = reliable_head + index;
+    if (slot >= EXT_PACK_RELIABLE_WINDOW) {
+        slot -= EXT_PACK_RELIABLE_WINDOW;
+    }
+    return &reliable_slots[slot];
+}
+
+/*
+ * Checks if a command with the data is in flight (its ACK could not be matched unambiguously).
+ */
+static uint8_t is_reliable_data_in_flight(uint8_t data) {
+    for (uint8_t i = 0; i < reliable_amount; i++) {
+        volatile reliable_slot_t* slot = get_reliable_slot(i);
+        if (slot->state == RELIABLE_SENT && slot->data == data) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Removes the completed commands from the front of the queue and calls their completion callback (in queue order).
+ */
+static uint8_t complete_reliable_commands() {
+    uint8_t completed = 0;
+    while (reliable_amount > 0) {
+        volatile reliable_slot_t* slot = get_reliable_slot(0);
+        uint8_t state = slot->state;
+        if (state != RELIABLE_ACKED && state != RELIABLE_FAILED) {
+            break;
+        }
+        unit_t unit = slot->unit;
+        uint8_t data = slot->data;
+        uint8_t interrupt_state = enter_critical_zone();
+        reliable_head = reliable_head + 1 < EXT_PACK_RELIABLE_WINDOW ? reliable_head + 1 : 0;
+        reliable_amount--;
+        if (state == RELIABLE_ACKED) {
+            reliable_stats.completed++;
+        } else {
+            reliable_stats.failed++;
+        }
+        exit_critical_zone(interrupt_state);
+        if (reliable_callback != NULL) {
+            reliable_callback(unit, data, state == RELIABLE_ACKED ? EXT_PACK_SUCCESS : EXT_PACK_FAILURE);
+        }
+        completed++;
+    }
+    return completed;
+}
+#endif
+
+ext_pack_error_t init_ExtPack_reliable_send(uint8_t window, uint16_t timeout_us, uint8_t max_tries, ext_pack_reliable_callback_t callback) {
+#if EXT_PACK_RELIABLE_WINDOW > 0
+    if (window == 0 || window > EXT_PACK_RELIABLE_WINDOW || max_tries == 0 || reliable_amount > 0) {
+        return EXT_PACK_FAILURE;
+    }
+    reliable_window = window;
+    reliable_timeout_us = timeout_us;
+    reliable_max_tries = max_tries;
+    reliable_callback = callback;
+#if !EXT_PACK_STATIC_UNITS
+    set_ExtPack_custom_ISR(unit_U02, process_ExtPack_reliable_ack);
+#endif
+    return EXT_PACK_SUCCESS;
+#else
+    return EXT_PACK_FAILURE;
+#endif
+}
+
+ext_pack_error_t queue_ExtPack_reliable_command(unit_t unit, uint8_t data) {
+#if EXT_PACK_RELIABLE_WINDOW > 0
+    if ((unit & 0x3F) >= USED_UNITS || reliable_amount == EXT_PACK_RELIABLE_WINDOW) {
+        return EXT_PACK_FAILURE;
+    }
+    volatile reliable_slot_t* slot = get_reliable_slot(reliable_amount);
+    slot->unit = unit;
+    slot->data = data;
+    slot->state = RELIABLE_QUEUED;
+    slot->tries = 0;
+    uint8_t interrupt_state = enter_critical_zone();
+    reliable_amount++;
+    exit_critical_zone(interrupt_state);
+    return EXT_PACK_SUCCESS;
+#else
+    return EXT_PACK_FAILURE;
+#endif
+}
+
+uint8_t run_ExtPack_reliable_send() {
+#if EXT_PACK_RELIABLE_WINDOW > 0
+    uint8_t completed = complete_reliable_commands();
+    // Timeouts
+    uint8_t in_flight = 0;
+    for (uint8_t i = 0; i < reliable_amount; i++) {
+        volatile reliable_slot_t* slot = get_reliable_slot(i);
+        if (slot->state != RELIABLE_SENT) {
+            continue;
+        }
+        ext_pack_deadline_t deadline = slot->deadline;
+        uint8_t expired = is_ExtPack_deadline_expired(&deadline);
+        uint8_t interrupt_state = enter_critical_zone();
+        if (slot->state == RELIABLE_SENT) {
+            // Not acknowledged in the meantime
+            if (expired) {
+                slot->state = RELIABLE_QUEUED;
+                reliable_stats.timeouts++;
+            } else {
+                in_flight++;
+            }
+        }
+        exit_critical_zone(interrupt_state);
+    }
+    // Sends in queue order until the window is full
+    for (uint8_t i = 0; i < reliable_amount && in_flight < reliable_window; i++) {
+        volatile reliable_slot_t* slot = get_reliable_slot(i);
+        if (slot->state != RELIABLE_QUEUED) {
+            continue;
+        }
+        if (slot->tries >= reliable_max_tries) {
+            slot->state = RELIABLE_FAILED;
+            continue;
+        }
+        if (is_reliable_data_in_flight(slot->data)) {
+            break; // Waits for the ACK of the command with the same data
+        }
+        uint16_t timeout_us = reliable_timeout_us;
+        if (timeout_us == 0) {
+            // Adaptive, doubled for every send again
+            uint32_t adaptive_timeout_us = slot->tries < 16 ? (uint32_t)get_ExtPack_ACK_timeout(get_ExtPack_unit_type(slot->unit & 0x3F)) << slot->tries : UINT16_MAX;
+            timeout_us = adaptive_timeout_us > UINT16_MAX ? UINT16_MAX : (uint16_t)adaptive_timeout_us;
+        }
+        uint8_t interrupt_state = enter_critical_zone();
+        // Sent state before the ACK is able to arrive
+        if (_send_to_ExtPack(slot->unit, slot->data) == EXT_PACK_FAILURE) {
+            exit_critical_zone(interrupt_state);
+            break; // Send buffer full
+        }
+        slot->timeout_us = timeout_us;
+        slot->deadline = get_ExtPack_deadline(timeout_us);
+        slot->sequence = next_reliable_sequence++;
+        slot->state = RELIABLE_SENT;
+        if (slot->tries > 0) {
+            reliable_stats.retransmissions++;
+        }
+        slot->tries++;
+        exit_critical_zone(interrupt_state);
+        in_flight++;
+    }
+    return completed + complete_reliable_commands();
+#else
+    return 0;
+#endif
+}
+
+ext_pack_error_t flush_ExtPack_reliable_send(uint32_t timeout_us) {
+    ext_pack_deadline_t deadline = get_ExtPack_deadline(timeout_us);
+    while (1) {
+        run_ExtPack_reliable_send();
+        if (get_ExtPack_reliable_pending() == 0) {
+            return EXT_PACK_SUCCESS;
+        }
+        if (is_ExtPack_deadline_expired(&deadline)) {
+            return EXT_PACK_FAILURE;
+        }
+    }
+}
+
+uint8_t get_ExtPack_reliable_pending() {
+#if EXT_PACK_RELIABLE_WINDOW > 0
+    return reliable_amount;
+#else
+    return 0;
+#endif
+}
+
+void process_ExtPack_reliable_ack(unit_t unit, uint8_t data) {
+    (void)unit;
+#if EXT_PACK_RELIABLE_WINDOW > 0
+    for (uint8_t i = 0; i < reliable_amount; i++) {
+        volatile reliable_slot_t* slot = get_reliable_slot(i);
+        if (slot->state == RELIABLE_SENT && slot->data == data) {
+            slot->state = RELIABLE_ACKED;
+            if (reliable_timeout_us == 0 && slot->tries == 1) {
+                // Round trip time since the send (ACKs of commands sent again are ambiguous)
+                add_ExtPack_ACK_rtt_sample(get_ExtPack_unit_type(slot->unit & 0x3F), get_ExtPack_now_us() - (slot->deadline - slot->timeout_us));
+            }
+            // The ExtPack acknowledges in send order --> Commands in flight sent before got lost
+            for (uint8_t j = 0; j < reliable_amount; j++) {
+                volatile reliable_slot_t* lost_slot = get_reliable_slot(j);
+                if (lost_slot->state == RELIABLE_SENT && (int16_t)(lost_slot->sequence - slot->sequence) < 0) {
+                    lost_slot->state = RELIABLE_QUEUED;
+                }
+            }
+            return;
+        }
+    }
+#endif
+    reliable_stats.unmatched_acks++;
+}
+
+void get_ExtPack_reliable_stats(ext_pack_reliable_stats_t* stats) {
+    uint8_t interrupt_state = enter_critical_zone();
+    *stats = reliable_stats;
+    exit_critical_zone(interrupt_state);
+}
+
+void reset_ExtPack_reliable_stats() {
+    uint8_t interrupt_state = enter_critical_zone();
+    reliable_stats = (ext_pack_reliable_stats_t){0};
+    exit_critical_zone(interrupt_state);
+}
@@ -0,0 +1,147 @@
+/**
+ * @file ExtPack_Reliable_Send.h
+ *
+ * @brief Pipelined acknowledged sending of commands with retransmission.
+ *
+ * @layer Service
+ *
+ * @details Instead of waiting for the ACK of every command (wait_for_ExtPack_ACK_data()), up to `window` commands are
+ * sent before their ACKs return. process_ExtPack_reliable_ack() matches every received ACK to the oldest command in flight
+ * with the same data. A command is sent again if its ACK is not received within the timeout or if the ACK of a later command
+ * is received first (the command got lost). After max_tries sends the command fails.
+ * run_ExtPack_reliable_send() called in the main loop sends the queued commands, handles the timeouts and calls the
+ * completion callback of every command in queue order.
+ *
+ * The ExtPack acknowledges every command (except to the Reset unit) with its data only, so
+ * - no other commands may be sent while commands are in flight (their ACKs are counted as unmatched) and
+ * - commands with the same data are not in flight at the same time (they are sent one after the other).
+ *
+ * @note The ExtPack executes a lost and sent again command after the later commands of the window, and a command whose ACK got lost
+ * is executed twice. Use a window of 1 if the order matters.
+ * @note The ACK unit has to be enabled (set_ExtPack_ACK_enable()) before.
+ *
+ * Set the compiler flag `-DEXT_PACK_RELIABLE_WINDOW=<Amount>` for the amount of queued commands. 0 removes the reliable sending.
+ * It needs `EXT_PACK_TIMEBASE=1` (default 4 with the timebase, otherwise 0), the timeouts are deadlines of the microsecond clock
+ * checked by run_ExtPack_reliable_send() without waiting.
+ *
+ * ## Provided Functions:
+ * - init_ExtPack_reliable_send: Sets the window, timeout, tries and completion callback.
+ * - queue_ExtPack_reliable_command: Queues a command to send acknowledged.
+ * - run_ExtPack_reliable_send: Sends, retransmits and completes the queued commands.
+ * - flush_ExtPack_reliable_send: Blocks until all queued commands are completed.
+ * - process_ExtPack_reliable_ack: Custom ISR of the ACK unit matching the ACKs.
+ * - get_ExtPack_reliable_stats / reset_ExtPack_reliable_stats: Retransmission statistics.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_RELIABLE_SEND_H
+#define EXTPACK_RELIABLE_SEND_H
+
+#include "../Core/ExtPack.h"
+
+/**
+ * @typedef ext_pack_reliable_callback_t
+ * @brief Called in the main context for every completed command with EXT_PACK_SUCCESS (acknowledged) or EXT_PACK_FAILURE (all tries failed).
+ */
+typedef void (*ext_pack_reliable_callback_t)(unit_t unit, uint8_t data, ext_pack_error_t result);
+
+/**
+ * @brief Statistics of the reliable sending.
+ */
+typedef struct {
+    uint16_t completed;         /**< Acknowledged commands */
+    uint16_t failed;            /**< Commands failed after max_tries sends */
+    uint16_t retransmissions;   /**< Commands sent again */
+    uint16_t timeouts;          /**< ACKs not received within the timeout */
+    uint16_t unmatched_acks;    /**< ACKs matching no command in flight (late, duplicated or of other commands) */
+} ext_pack_reliable_stats_t;
+
+/**
+ * @brief Initializes the reliable sending and sets the custom ISR of the ACK unit (unit_U02) to process_ExtPack_reliable_ack().
+ *
+ * @layer Service
+ *
+ * @note With EXT_PACK_STATIC_UNITS = 1 configure process_ExtPack_reliable_ack as custom ISR of the ACK unit in EXT_PACK_UNITS.
+ *
+ * @param window The maximum amount of commands in flight (1 to EXT_PACK_RELIABLE_WINDOW, 1 is stop-and-wait).
+ * @param timeout_us The time in us to wait for the ACK of a command before sending it again.
+ *        0 uses the adaptive timeout of the unit type (get_ExtPack_ACK_timeout()) doubled for every send again,
+ *        the round trip times of the first sends update its estimation.
+ * @param max_tries The maximum amount of sends per command (at least 1).
+ * @param callback The completion callback or 'NULL'.
+ * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE if a parameter is invalid or commands are still queued.
+ */
+ext_pack_error_t init_ExtPack_reliable_send(uint8_t window, uint16_t timeout_us, uint8_t max_tries, ext_pack_reliable_callback_t callback);
+
+/**
+ * @brief Queues a command to be sent acknowledged by run_ExtPack_reliable_send().
+ *
+ * @layer Service
+ *
+ * @param unit The ExtPack unit to which the data should be sent. Including the correct set access mode for sending.
+ * @param data The data to send.
+ * @return EXT_PACK_SUCCESS if queued, EXT_PACK_FAILURE if the queue is full or the unit is not used.
+ */
+ext_pack_error_t queue_ExtPack_reliable_command(unit_t unit, uint8_t data);
+
+/**
+ * @brief Completes the acknowledged and failed commands, sends the queued commands and retransmits the timed out ones.
+ *
+ * @layer Service
+ *
+ * @warning Do not call it from a custom ISR or another ISR.
+ *
+ * @return The amount of completed commands (acknowledged or failed).
+ */
+uint8_t run_ExtPack_reliable_send();
+
+/**
+ * @brief Calls run_ExtPack_reliable_send() until all queued commands are completed or the timeout is over.
+ *
+ * @layer Service
+ *
+ * @param timeout_us Maximum time awaited in us.
+ * @return EXT_PACK_SUCCESS if all commands are completed (acknowledged or failed), EXT_PACK_FAILURE if the timeout is reached.
+ */
+ext_pack_error_t flush_ExtPack_reliable_send(uint32_t timeout_us);
+
+/**
+ * @brief Returns the amount of queued commands (not yet completed).
+ *
+ * @layer Service
+ *
+ * @return The amount of queued commands.
+ */
+uint8_t get_ExtPack_reliable_pending();
+
+/**
+ * @brief Custom ISR of the ACK unit matching the received ACK to the oldest command in flight with the same data.
+ *
+ * @layer Service
+ *
+ * @details Commands sent before the matched command are sent again by the next run_ExtPack_reliable_send().
+ *
+ * @param unit The ACK unit (unit_U02).
+ * @param data The received ACK data.
+ */
+void process_ExtPack_reliable_ack(unit_t unit, uint8_t data);
+
+/**
+ * @brief Copies the statistics of the reliable sending consistently.
+ *
+ * @layer Service
+ *
+ * @param stats Destination of the statistics.
+ */
+void get_ExtPack_reliable_stats(ext_pack_reliable_stats_t* stats);
+
+/**
+ * @brief Sets all statistics of the reliable sending to zero.
+ *
+ * @layer Service
+ */
+void reset_ExtPack_reliable_stats();
+
+#endif //EXTPACK_RELIABLE_SEND_H
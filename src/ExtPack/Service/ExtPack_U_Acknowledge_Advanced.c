@@ -1,36 +1,147 @@
 #include "ExtPack_U_Acknowledge_Advanced.h"
+#include "ExtPack_Advanced.h"
 #include "../Core/ExtPack_Internal.h"
 #include "../Core/ExtPack_Events.h"
-#include <util/delay.h>
+#include "../Core/ExtPack_Timebase.h"
+
+/**
+ * @def ACK_RTT_MAX_US
+ * @brief Largest round trip time of the estimation (the smoothed round trip time is stored multiplied by 8 in 16 bit).
+ */
+#define ACK_RTT_MAX_US 8191
+
+/*
+ * Round trip time estimation of a unit type in fixed point:
+ * srtt_x8 = 8 * srtt (gain 1/8) and rttvar_x4 = 4 * rttvar (gain 1/4).
+ */
+typedef struct {
+    uint16_t srtt_x8;
+    uint16_t rttvar_x4;
+    uint16_t samples;
+} ack_rtt_estimation_t;
+
+volatile ack_rtt_estimation_t ack_rtt_estimations[EXTPACK_SRAM_UNIT + 1] = {0};
+
+/*
+ * Computes the adaptive timeout of an estimation.
+ */
+static uint16_t get_ack_rtt_timeout(const ack_rtt_estimation_t* estimation) {
+    if (estimation->samples == 0) {
+        return EXT_PACK_ACK_INITIAL_TIMEOUT_US;
+    }
+    uint32_t timeout_us = (estimation->srtt_x8 >> 3) + (uint32_t)estimation->rttvar_x4; // srtt + 4 * rttvar
+    if (timeout_us < EXT_PACK_ACK_MIN_TIMEOUT_US) {
+        return EXT_PACK_ACK_MIN_TIMEOUT_US;
+    }
+    return timeout_us > UINT16_MAX ? UINT16_MAX : (uint16_t)timeout_us;
+}
 
 ext_pack_error_t wait_for_ExtPack_ACK_data(uint8_t data, uint16_t timeout_us) {
-    for (uint16_t i = 0; i < timeout_us; i++) {
-        _delay_us(1);
-        if (get_ExtPack_event(unit_U02)) {
-            // Acknowledgement received
-            clear_ExtPack_event(unit_U02);
-            if (unit_data[unit_U02].input_values == data) {
-                // Matching acknowledgment data
-                return EXT_PACK_SUCCESS;
-            } else {
-                // Wrong acknowledgment data
-                return EXT_PACK_FAILURE;
+    if (wait_for_ExtPack_event(unit_U02, timeout_us) == EXT_PACK_FAILURE) {
+        // Timeout exceeded
+        return EXT_PACK_FAILURE;
+    }
+    // Acknowledgement received
+    clear_ExtPack_event(unit_U02);
+    if (get_ExtPack_stored_unit_input_values(unit_U02) == data) {
+        // Matching acknowledgment data
+        return EXT_PACK_SUCCESS;
+    } else {
+        // Wrong acknowledgment data
+        return EXT_PACK_FAILURE;
+    }
+}
+
+ext_pack_error_t send_ExtPack_acknowledged(unit_t unit, uint8_t access_mode, uint8_t data, uint8_t max_tries) {
+    if ((unit & 0x3F) >= USED_UNITS) {
+        return EXT_PACK_FAILURE;
+    }
+    unit_type_t unit_type = get_ExtPack_unit_type(unit & 0x3F);
+    uint16_t timeout_us = get_ExtPack_ACK_timeout(unit_type);
+    for (uint8_t tries = 0; tries < max_tries; tries++) {
+        if (wait_ExtPack_tx_space(1, timeout_us) == EXT_PACK_FAILURE) {
+            return EXT_PACK_FAILURE; // Not sent --> No try and no round trip time
+        }
+        clear_ExtPack_event(unit_U02);
+        uint32_t sent_us = get_ExtPack_now_us();
+        if (_send_to_ExtPack(_set_ExtPack_access_mode(unit, access_mode), data) == EXT_PACK_SUCCESS && wait_for_ExtPack_ACK_data(data, timeout_us) == EXT_PACK_SUCCESS) {
+#if EXT_PACK_TIMEBASE
+            if (tries == 0) {
+                // ACKs of a command sent again are ambiguous --> Only first sends are measured
+                add_ExtPack_ACK_rtt_sample(unit_type, get_ExtPack_now_us() - sent_us);
             }
+#else
+            (void)sent_us;
+#endif
+            return EXT_PACK_SUCCESS;
         }
+        timeout_us = timeout_us > UINT16_MAX / 2 ? UINT16_MAX : timeout_us * 2; // Backoff, the ExtPack may be overloaded
     }
-    // Timeout exceeded
     return EXT_PACK_FAILURE;
 }
 
-ext_pack_error_t wait_for_ExtPack_ACK(uint16_t timeout_us) {
-    for (uint16_t i = 0; i < timeout_us; i++) {
-        _delay_us(1);
-        if (get_ExtPack_event(unit_U02)) {
-            // Acknowledgement received
-            clear_ExtPack_event(unit_U02);
-            return EXT_PACK_SUCCESS;
+uint16_t get_ExtPack_ACK_timeout(unit_type_t unit_type) {
+    if (unit_type > EXTPACK_SRAM_UNIT) {
+        return EXT_PACK_ACK_INITIAL_TIMEOUT_US;
+    }
+    uint8_t interrupt_state = enter_critical_zone();
+    ack_rtt_estimation_t estimation = ack_rtt_estimations[unit_type];
+    exit_critical_zone(interrupt_state);
+    return get_ack_rtt_timeout(&estimation);
+}
+
+void add_ExtPack_ACK_rtt_sample(unit_type_t unit_type, uint32_t rtt_us) {
+    if (unit_type > EXTPACK_SRAM_UNIT) {
+        return;
+    }
+    int16_t rtt = rtt_us > ACK_RTT_MAX_US ? ACK_RTT_MAX_US : (int16_t)rtt_us;
+    uint8_t interrupt_state = enter_critical_zone();
+    volatile ack_rtt_estimation_t* estimation = &ack_rtt_estimations[unit_type];
+    if (estimation->samples == 0) {
+        // First measurement: srtt = rtt, rttvar = rtt / 2
+        estimation->srtt_x8 = rtt << 3;
+        estimation->rttvar_x4 = rtt << 1;
+    } else {
+        int16_t error = rtt - (int16_t)(estimation->srtt_x8 >> 3);
+        estimation->srtt_x8 += error; // srtt += error / 8
+        if (error < 0) {
+            error = -error;
         }
+        estimation->rttvar_x4 += error - (int16_t)(estimation->rttvar_x4 >> 2); // rttvar += (|error| - rttvar) / 4
     }
-    // Timeout exceeded
-    return EXT_PACK_FAILURE;
+    if (estimation->samples < UINT16_MAX) {
+        estimation->samples++;
+    }
+    exit_critical_zone(interrupt_state);
+}
+
+void get_ExtPack_ACK_rtt(unit_type_t unit_type, ext_pack_ack_rtt_t* rtt) {
+    ack_rtt_estimation_t estimation = {0};
+    if (unit_type <= EXTPACK_SRAM_UNIT) {
+        uint8_t interrupt_state = enter_critical_zone();
+        estimation = ack_rtt_estimations[unit_type];
+        exit_critical_zone(interrupt_state);
+    }
+    rtt->srtt_us = estimation.srtt_x8 >> 3;
+    rtt->rttvar_us = estimation.rttvar_x4 >> 2;
+    rtt->timeout_us = get_ack_rtt_timeout(&estimation);
+    rtt->samples = estimation.samples;
+}
+
+void reset_ExtPack_ACK_rtt() {
+    uint8_t interrupt_state = enter_critical_zone();
+    for (uint8_t unit_type = 0; unit_type <= EXTPACK_SRAM_UNIT; unit_type++) {
+        ack_rtt_estimations[unit_type] = (ack_rtt_estimation_t){0};
+    }
+    exit_critical_zone(interrupt_state);
+}
+
+ext_pack_error_t wait_for_ExtPack_ACK(uint16_t timeout_us) {
+    if (wait_for_ExtPack_event(unit_U02, timeout_us) == EXT_PACK_FAILURE) {
+        // Timeout exceeded
+        return EXT_PACK_FAILURE;
+    }
+    // Acknowledgement received
+    clear_ExtPack_event(unit_U02);
+    return EXT_PACK_SUCCESS;
 }
\ No newline at end of file
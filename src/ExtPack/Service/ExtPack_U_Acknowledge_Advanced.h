@@ -7,10 +7,21 @@
  *
  * @details This header provides blocking functions to wait for acknowledgments from the ACK unit,
  * with optional data checking and timeout handling.
+ * With EXT_PACK_SLEEP_WAIT = 1 the controller sleeps while waiting (see wait_for_ExtPack_event()).
+ * To keep several acknowledged commands in flight instead of waiting for every ACK see ExtPack_Reliable_Send.h.
+ *
+ * The round trip time from sending a command until its ACK is received is estimated per unit type
+ * (smoothed round trip time and mean deviation as in TCP, RFC 6298). The adaptive timeout is srtt + 4 * rttvar,
+ * so it follows the load of the ExtPack instead of a hard-coded timeout. Only first sends are measured, the ACK of
+ * a command sent again could belong to any of its sends. The measurement needs EXT_PACK_TIMEBASE = 1.
  *
  * ## Provided Functions:
  * - wait_for_ExtPack_ACK_data: Waits for an ACK and verifies the received data.
  * - wait_for_ExtPack_ACK: Waits for any ACK without checking the data.
+ * - send_ExtPack_acknowledged: Sends a command until it is acknowledged, with the adaptive timeout.
+ * - get_ExtPack_ACK_timeout: Returns the adaptive timeout of a unit type.
+ * - add_ExtPack_ACK_rtt_sample: Updates the estimation of a unit type with a measured round trip time.
+ * - get_ExtPack_ACK_rtt / reset_ExtPack_ACK_rtt: Current estimation for instrumentation.
  *
  * @author Markus Remy
  * @date 04.08.2025
@@ -21,6 +32,16 @@
 
 #include "../Util/ExtPack_U_Acknowledge.h"
 
+/**
+ * @brief Round trip time estimation of the ACKs of a unit type.
+ */
+typedef struct {
+    uint16_t srtt_us;       /**< Smoothed round trip time in us */
+    uint16_t rttvar_us;     /**< Smoothed mean deviation of the round trip time in us */
+    uint16_t timeout_us;    /**< Adaptive timeout in us (see get_ExtPack_ACK_timeout()) */
+    uint16_t samples;       /**< Amount of measured round trip times */
+} ext_pack_ack_rtt_t;
+
 /**
  * @defgroup ACK_Unit Acknowledge Unit
  * @brief Functionality of the Acknowledge Unit of ExtPack
@@ -58,6 +79,67 @@ ext_pack_error_t wait_for_ExtPack_ACK_data(uint8_t data, uint16_t timeout_us);
  */
 ext_pack_error_t wait_for_ExtPack_ACK(uint16_t timeout_us);
 
+/**
+ * @brief Sends a command and waits for its ACK with the adaptive timeout of the unit type.
+ * Sends the command again on timeout or wrong ACK data with the doubled timeout.
+ *
+ * @layer Service
+ *
+ * @details The round trip time of the first send updates the estimation of the unit type.
+ * Replaces the loops of _send_to_ExtPack() and wait_for_ExtPack_ACK_data() with hard-coded timeouts.
+ * A full send buffer is no lost command: If there is no space within the timeout the function aborts without sending again.
+ *
+ * @param unit The ExtPack unit to which the data should be sent.
+ * @param access_mode The access mode of the command (p.ex. 0b00 for I2C data and 0b10 for an I2C read request).
+ * @param data The data to send (the expected ACK data).
+ * @param max_tries The maximum amount of sends.
+ * @return EXT_PACK_SUCCESS if the command is acknowledged,
+ *         EXT_PACK_FAILURE if all tries failed, the send buffer has no space or the unit is not used.
+ */
+ext_pack_error_t send_ExtPack_acknowledged(unit_t unit, uint8_t access_mode, uint8_t data, uint8_t max_tries);
+
+/**
+ * @brief Returns the adaptive ACK timeout of the unit type.
+ *
+ * @layer Service
+ *
+ * @details srtt + 4 * rttvar, at least EXT_PACK_ACK_MIN_TIMEOUT_US.
+ * EXT_PACK_ACK_INITIAL_TIMEOUT_US until the first round trip time of the unit type is measured.
+ *
+ * @param unit_type The unit type of the acknowledged command (p.ex. EXTPACK_I2C_UNIT).
+ * @return The timeout in us.
+ */
+uint16_t get_ExtPack_ACK_timeout(unit_type_t unit_type);
+
+/**
+ * @brief Updates the round trip time estimation of the unit type with a measured round trip time.
+ *
+ * @layer Service
+ *
+ * @note Callable from ISRs. Round trip times above 8191 us are limited to it.
+ *
+ * @param unit_type The unit type of the acknowledged command.
+ * @param rtt_us The time in us from sending the command until its ACK was received.
+ */
+void add_ExtPack_ACK_rtt_sample(unit_type_t unit_type, uint32_t rtt_us);
+
+/**
+ * @brief Copies the current round trip time estimation of the unit type.
+ *
+ * @layer Service
+ *
+ * @param unit_type The unit type.
+ * @param rtt Destination of the estimation.
+ */
+void get_ExtPack_ACK_rtt(unit_type_t unit_type, ext_pack_ack_rtt_t* rtt);
+
+/**
+ * @brief Discards the round trip time estimations of all unit types.
+ *
+ * @layer Service
+ */
+void reset_ExtPack_ACK_rtt();
+
 /** @} */
 
 #endif //EXTPACK_U_ACKNOWLEDGE_ADVANCED_H
\ No newline at end of file
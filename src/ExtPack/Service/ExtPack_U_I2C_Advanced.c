@@ -1,26 +1,57 @@
 #include "ExtPack_U_I2C_Advanced.h"
+#include "../Core/ExtPack_Internal.h"
 #include "../Util/Dynamic_Delay.h"
 
-ext_pack_error_t receive_ExtPack_I2C_data_from_partner(unit_t unit, uint8_t partner_adr) {
-    if(set_ExtPack_I2C_partner_adr(unit, partner_adr) == EXT_PACK_FAILURE) {
+/*
+ * Sends the partner address (skipped if already set) and the command as one transaction --> Commands of custom ISRs can not change the partner in between.
+ */
+static ext_pack_error_t send_ExtPack_I2C_command_to_partner(unit_t unit, uint8_t partner_adr, uint8_t access_mode, uint8_t data, uint16_t command_timeout_us) {
+    const ext_pack_command_t partner = { _set_ExtPack_access_mode(unit, 0b01), partner_adr };
+    const ext_pack_command_t command = { _set_ExtPack_access_mode(unit, access_mode), data };
+    if(send_configured_command_to_ExtPack(partner, command, command_timeout_us) == EXT_PACK_FAILURE) {
         return EXT_PACK_FAILURE;
     }
-    delay_us(get_ExtPack_send_duration_us());
-    return receive_ExtPack_I2C_data(unit);
+    get_ExtPack_unit_data(unit)->output_values = partner_adr; // Save partner_adr locally (like set_ExtPack_I2C_partner_adr)
+    return EXT_PACK_SUCCESS;
 }
 
-ext_pack_error_t send_ExtPack_I2C_data_to_partner(unit_t unit, uint8_t partner_adr, uint8_t data) {
-    if(set_ExtPack_I2C_partner_adr(unit, partner_adr) == EXT_PACK_FAILURE) {
+/*
+ * Sets the partner address without data (empty String or buffer).
+ */
+static ext_pack_error_t select_ExtPack_I2C_partner(unit_t unit, uint8_t partner_adr, uint16_t timeout_us) {
+    if (wait_ExtPack_tx_space(1, timeout_us) == EXT_PACK_FAILURE) {
         return EXT_PACK_FAILURE;
     }
-    delay_us(get_ExtPack_send_duration_us());
-    return send_ExtPack_I2C_data(unit, data);
+    return set_ExtPack_I2C_partner_adr(unit, partner_adr);
+}
+
+ext_pack_error_t receive_ExtPack_I2C_data_from_partner(unit_t unit, uint8_t partner_adr) {
+    return send_ExtPack_I2C_command_to_partner(unit, partner_adr, 0b10, 0x00, get_ExtPack_send_duration_us());
+}
+
+ext_pack_error_t send_ExtPack_I2C_data_to_partner(unit_t unit, uint8_t partner_adr, uint8_t data) {
+    return send_ExtPack_I2C_command_to_partner(unit, partner_adr, 0b00, data, get_ExtPack_send_duration_us());
 }
 
 ext_pack_error_t send_ExtPack_I2C_String_to_partner(unit_t unit, uint8_t partner_adr, const uint8_t* data, uint16_t send_byte_delay_us) {
-    if(set_ExtPack_I2C_partner_adr(unit, partner_adr) == EXT_PACK_FAILURE) {
+    if (data[0] == '\0') {
+        return select_ExtPack_I2C_partner(unit, partner_adr, get_ExtPack_send_duration_us());
+    }
+    // Partner address with the first byte --> The rest follows the set partner in the send buffer
+    if(send_ExtPack_I2C_command_to_partner(unit, partner_adr, 0b00, data[0], get_ExtPack_send_duration_us()) == EXT_PACK_FAILURE) {
         return EXT_PACK_FAILURE;
     }
-    delay_us(get_ExtPack_send_duration_us()); // Not affected by bitrate between ExtPack and partner
-    return send_String_to_ExtPack(unit, data, send_byte_delay_us);
-}
\ No newline at end of file
+    delay_us(send_byte_delay_us);
+    return send_String_to_ExtPack(_set_ExtPack_access_mode(unit, 0b00), data + 1, send_byte_delay_us);
+}
+
+ext_pack_error_t send_ExtPack_I2C_buffer_to_partner(unit_t unit, uint8_t partner_adr, const uint8_t* buf, uint16_t len, uint16_t timeout_us) {
+    if (len == 0) {
+        return select_ExtPack_I2C_partner(unit, partner_adr, timeout_us);
+    }
+    // Partner address with the first byte --> No delay needed, the rest waits behind them in the send buffer
+    if(send_ExtPack_I2C_command_to_partner(unit, partner_adr, 0b00, buf[0], timeout_us) == EXT_PACK_FAILURE) {
+        return EXT_PACK_FAILURE;
+    }
+    return send_ExtPack_I2C_buffer(unit, buf + 1, len - 1, timeout_us);
+}
@@ -6,13 +6,15 @@
  * @layer Service
  *
  * @details This header provides advanced functions to send and receive data via the I2C unit of ExtPack.
- * Includes functions for setting the I2C partner address and sending strings with delays.
+ * Includes functions for setting the I2C partner address, sending strings with delays and binary buffers.
  *
  * ## Provided Functions:
  * - receive_ExtPack_I2C_data_from_partner: Request data from a given I2C partner.
  * - send_ExtPack_I2C_String: Send a string via I2C using the current partner configuration.
  * - send_ExtPack_I2C_data_to_partner: Send a single byte to a specific partner address.
  * - send_ExtPack_I2C_String_to_partner: Send a string to a specific partner address with delay.
+ * - send_ExtPack_I2C_buffer: Send a binary buffer via I2C using the current partner configuration.
+ * - send_ExtPack_I2C_buffer_to_partner: Send a binary buffer to a specific partner address.
  *
  * @author Markus Remy
  * @date 04.08.2025
@@ -36,6 +38,7 @@
  * @layer Service
  *
  * @note The received data will not be returned. Use the custom ISR to work with the received data.
+ * @note Sent as one transaction (see send_configured_command_to_ExtPack), commands of custom ISRs can not get in between.
  *
  * @param unit The I2C unit of ExtPack to receive data from.
  * @param partner_adr The partner address to get data from.
@@ -63,6 +66,8 @@ static inline ext_pack_error_t send_ExtPack_I2C_String(unit_t unit, const uint8_
  *
  * @layer Service
  *
+ * @note Sent as one transaction (see send_configured_command_to_ExtPack), commands of custom ISRs can not get in between.
+ *
  * @param unit The ExtPack unit to which the data should be sent.
  * @param partner_adr The partner address to send the data to.
  * @param data The data to be sent.
@@ -76,6 +81,9 @@ ext_pack_error_t send_ExtPack_I2C_data_to_partner(unit_t unit, uint8_t partner_a
  *
  * @layer Service
  *
+ * @note The partner address is sent together with the first byte as one transaction (see send_configured_command_to_ExtPack),
+ * commands of custom ISRs can not change it in between. Sending aborts if the send buffer has no space in time.
+ *
  * @param unit The ExtPack unit to which the data should be sent.
  * @param partner_adr The partner address to send the data to.
  * @param data The data to be sent as String with terminating '\0'.
@@ -84,6 +92,38 @@ ext_pack_error_t send_ExtPack_I2C_data_to_partner(unit_t unit, uint8_t partner_a
  */
 ext_pack_error_t send_ExtPack_I2C_String_to_partner(unit_t unit, uint8_t partner_adr, const uint8_t* data, uint16_t send_byte_delay_us);
 
+/**
+ * @brief Sends len bytes of the given buffer to ExtPack which then sends them over I2C.
+ *
+ * @layer Service
+ *
+ * @param unit The I2C unit of ExtPack to which the data should be sent.
+ * @param buf The data to be sent (may contain '\0').
+ * @param len The amount of bytes to send.
+ * @param timeout_us The maximum time in us to wait for space in the send buffer (see send_buffer_to_ExtPack()).
+ * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on failure.
+ */
+static inline ext_pack_error_t send_ExtPack_I2C_buffer(unit_t unit, const uint8_t* buf, uint16_t len, uint16_t timeout_us) {
+    return send_buffer_to_ExtPack(_set_ExtPack_access_mode(unit, 00), buf, len, timeout_us);
+}
+
+/**
+ * @brief Sends a set_ExtPack_I2C_partner_adr control message followed by len bytes of the given buffer to ExtPack.
+ *
+ * @layer Service
+ *
+ * @note The partner address is sent together with the first byte as one transaction (see send_configured_command_to_ExtPack),
+ * commands of custom ISRs can not change it in between.
+ *
+ * @param unit The I2C unit of ExtPack to which the data should be sent.
+ * @param partner_adr The partner address to send the data to.
+ * @param buf The data to be sent (may contain '\0').
+ * @param len The amount of bytes to send.
+ * @param timeout_us The maximum time in us to wait for space in the send buffer (see send_buffer_to_ExtPack()).
+ * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on timeout or failure.
+ */
+ext_pack_error_t send_ExtPack_I2C_buffer_to_partner(unit_t unit, uint8_t partner_adr, const uint8_t* buf, uint16_t len, uint16_t timeout_us);
+
 /** @} */
 
 #endif //EXTPACK_U_I2C_ADVANCED_H
\ No newline at end of file
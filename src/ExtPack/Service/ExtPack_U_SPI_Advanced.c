@@ -1,18 +1,53 @@
 #include "ExtPack_U_SPI_Advanced.h"
+#include "../Core/ExtPack_Internal.h"
 #include "../Util/Dynamic_Delay.h"
 
-ext_pack_error_t send_ExtPack_SPI_data_to_slave(unit_t unit, uint8_t slave_id, uint8_t data) {
-    if(set_ExtPack_SPI_slave(unit, slave_id) == EXT_PACK_FAILURE) {
+/*
+ * Sends the slave id (skipped if already selected) and the data as one transaction --> Commands of custom ISRs can not select another slave in between.
+ */
+static ext_pack_error_t send_ExtPack_SPI_command_to_slave(unit_t unit, uint8_t slave_id, uint8_t data, uint16_t command_timeout_us) {
+    const ext_pack_command_t slave = { _set_ExtPack_access_mode(unit, 0b01), slave_id };
+    const ext_pack_command_t command = { _set_ExtPack_access_mode(unit, 0b00), data };
+    if(send_configured_command_to_ExtPack(slave, command, command_timeout_us) == EXT_PACK_FAILURE) {
+        return EXT_PACK_FAILURE;
+    }
+    get_ExtPack_unit_data(unit)->output_values = slave_id; // Save slave_id locally (like set_ExtPack_SPI_slave)
+    return EXT_PACK_SUCCESS;
+}
+
+/*
+ * Selects the slave without data (empty String or buffer).
+ */
+static ext_pack_error_t select_ExtPack_SPI_slave(unit_t unit, uint8_t slave_id, uint16_t timeout_us) {
+    if (wait_ExtPack_tx_space(1, timeout_us) == EXT_PACK_FAILURE) {
         return EXT_PACK_FAILURE;
     }
-    delay_us(get_ExtPack_send_duration_us());
-    return send_ExtPack_SPI_data(unit, data);
+    return set_ExtPack_SPI_slave(unit, slave_id);
+}
+
+ext_pack_error_t send_ExtPack_SPI_data_to_slave(unit_t unit, uint8_t slave_id, uint8_t data) {
+    return send_ExtPack_SPI_command_to_slave(unit, slave_id, data, get_ExtPack_send_duration_us());
 }
 
 ext_pack_error_t send_ExtPack_SPI_String_to_slave(unit_t unit, uint8_t slave_id, const uint8_t* data, uint16_t send_byte_delay_us) {
-    if(set_ExtPack_SPI_slave(unit, slave_id) == EXT_PACK_FAILURE) {
+    if (data[0] == '\0') {
+        return select_ExtPack_SPI_slave(unit, slave_id, get_ExtPack_send_duration_us());
+    }
+    // Slave id with the first byte --> The rest follows the selected slave in the send buffer
+    if(send_ExtPack_SPI_command_to_slave(unit, slave_id, data[0], get_ExtPack_send_duration_us()) == EXT_PACK_FAILURE) {
         return EXT_PACK_FAILURE;
     }
-    delay_us(get_ExtPack_send_duration_us()); // Not affected by bitrate between ExtPack and partner
-    return send_String_to_ExtPack(_set_ExtPack_access_mode(unit, 00), data, send_byte_delay_us);
-}
\ No newline at end of file
+    delay_us(send_byte_delay_us);
+    return send_String_to_ExtPack(_set_ExtPack_access_mode(unit, 00), data + 1, send_byte_delay_us);
+}
+
+ext_pack_error_t send_ExtPack_SPI_buffer_to_slave(unit_t unit, uint8_t slave_id, const uint8_t* buf, uint16_t len, uint16_t timeout_us) {
+    if (len == 0) {
+        return select_ExtPack_SPI_slave(unit, slave_id, timeout_us);
+    }
+    // Slave id with the first byte --> No delay needed, the rest waits behind them in the send buffer
+    if(send_ExtPack_SPI_command_to_slave(unit, slave_id, buf[0], timeout_us) == EXT_PACK_FAILURE) {
+        return EXT_PACK_FAILURE;
+    }
+    return send_ExtPack_SPI_buffer(unit, buf + 1, len - 1, timeout_us);
+}
@@ -12,6 +12,8 @@
  * - send_ExtPack_SPI_data_to_slave: Sends one byte to a specific slave device.
  * - send_ExtPack_SPI_String_to_slave: Sends a string with delay to a specific slave device.
  * - send_ExtPack_SPI_String: Sends a string with delay using a previously configured access mode.
+ * - send_ExtPack_SPI_buffer: Sends a binary buffer to the currently selected slave.
+ * - send_ExtPack_SPI_buffer_to_slave: Sends a binary buffer to a specific slave device.
  *
  * @author Markus Remy
  * @date 04.08.2025
@@ -33,6 +35,8 @@
  *
  * @layer Service
  *
+ * @note Sent as one transaction (see send_configured_command_to_ExtPack), commands of custom ISRs can not get in between.
+ *
  * @param unit The ExtPack unit to which the data should be sent.
  * @param slave_id The slave id to send the data to.
  * @param data The data to be sent.
@@ -46,6 +50,9 @@ ext_pack_error_t send_ExtPack_SPI_data_to_slave(unit_t unit, uint8_t slave_id, u
  *
  * @layer Service
  *
+ * @note The slave id is sent together with the first byte as one transaction (see send_configured_command_to_ExtPack),
+ * commands of custom ISRs can not change it in between. Sending aborts if the send buffer has no space in time.
+ *
  * @param unit The ExtPack unit to which the data should be sent.
  * @param slave_id The slave id to send the data to.
  * @param data The data to be sent as String with terminating '\0'.
@@ -69,6 +76,38 @@ static inline ext_pack_error_t send_ExtPack_SPI_String(unit_t unit, const uint8_
     return send_String_to_ExtPack(_set_ExtPack_access_mode(unit, 00), data, send_byte_delay_us);
 }
 
+/**
+ * @brief Sends len bytes of the given buffer to ExtPack which then sends them over SPI.
+ *
+ * @layer Service
+ *
+ * @param unit The SPI unit of ExtPack to which the data should be sent.
+ * @param buf The data to be sent (may contain '\0').
+ * @param len The amount of bytes to send.
+ * @param timeout_us The maximum time in us to wait for space in the send buffer (see send_buffer_to_ExtPack()).
+ * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on failure.
+ */
+static inline ext_pack_error_t send_ExtPack_SPI_buffer(unit_t unit, const uint8_t* buf, uint16_t len, uint16_t timeout_us) {
+    return send_buffer_to_ExtPack(_set_ExtPack_access_mode(unit, 00), buf, len, timeout_us);
+}
+
+/**
+ * @brief Sends a set_ExtPack_SPI_slave control message followed by len bytes of the given buffer to ExtPack.
+ *
+ * @layer Service
+ *
+ * @note The slave id is sent together with the first byte as one transaction (see send_configured_command_to_ExtPack),
+ * commands of custom ISRs can not change it in between.
+ *
+ * @param unit The SPI unit of ExtPack to which the data should be sent.
+ * @param slave_id The slave id to send the data to.
+ * @param buf The data to be sent (may contain '\0').
+ * @param len The amount of bytes to send.
+ * @param timeout_us The maximum time in us to wait for space in the send buffer (see send_buffer_to_ExtPack()).
+ * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on timeout or failure.
+ */
+ext_pack_error_t send_ExtPack_SPI_buffer_to_slave(unit_t unit, uint8_t slave_id, const uint8_t* buf, uint16_t len, uint16_t timeout_us);
+
 /** @} */
 
 #endif //EXTPACK_U_SPI_ADVANCED_H
\ No newline at end of file
@@ -2,55 +2,57 @@
 #include "ExtPack_Advanced.h"
 #include "../Core/ExtPack_Internal.h"
 #include "../Core/ExtPack_Events.h"
-#include "../Util/Dynamic_Delay.h"
-#include <util/delay.h>
 
-ext_pack_error_t set_ExtPack_SRAM_address(unit_t unit, uint32_t address, uint16_t send_byte_delay_us) {
-    if (reset_ExtPack_SRAM_address(unit) == EXT_PACK_FAILURE) {
-        return EXT_PACK_FAILURE;
+/**
+ * @def SRAM_ADDRESS_COMMANDS
+ * @brief Amount of commands to set an address: reset + 3 address bytes (LSB first, hold the 19 bit address).
+ */
+#define SRAM_ADDRESS_COMMANDS 4
+
+/*
+ * Fills the commands setting the address (address bytes may be zero).
+ */
+static void fill_ExtPack_SRAM_address_commands(unit_t unit, uint32_t address, ext_pack_command_t* commands) {
+    commands[0] = (ext_pack_command_t){ _set_ExtPack_access_mode(unit, 0b00), 0x00 };
+    for (uint8_t i = 0; i < SRAM_ADDRESS_COMMANDS - 1; i++) {
+        commands[i + 1] = (ext_pack_command_t){ _set_ExtPack_access_mode(unit, 0b01), (uint8_t)(address >> (i * 8)) };
     }
-    uint8_t address_string[5];
-    address_string[0] = address;
-    address_string[1] = address >> 8;
-    address_string[2] = address >> 16;
-    address_string[3] = address >> 24;
-    address_string[4] = '\0'; // String end
-    return send_String_to_ExtPack(unit, address_string, send_byte_delay_us);
 }
 
-ext_pack_error_t write_ExtPack_SRAM_data_to_address(unit_t unit, uint32_t address, uint8_t data, uint16_t send_byte_delay_us) {
-    if (set_ExtPack_SRAM_address(unit, address, send_byte_delay_us) == EXT_PACK_FAILURE) {
-        return EXT_PACK_FAILURE;
-    }
-    delay_us(send_byte_delay_us);
-    return write_ExtPack_SRAM_data(unit, data);
+ext_pack_error_t set_ExtPack_SRAM_address(unit_t unit, uint32_t address, uint16_t command_timeout_us) {
+    ext_pack_command_t commands[SRAM_ADDRESS_COMMANDS];
+    fill_ExtPack_SRAM_address_commands(unit, address, commands);
+    return send_transaction_to_ExtPack(commands, SRAM_ADDRESS_COMMANDS, command_timeout_us);
 }
 
-ext_pack_error_t request_ExtPack_SRAM_data_from_address(unit_t unit, uint32_t address, uint16_t send_byte_delay_us) {
-    if (set_ExtPack_SRAM_address(unit, address, send_byte_delay_us) == EXT_PACK_FAILURE) {
-        return EXT_PACK_FAILURE;
-    }
-    delay_us(send_byte_delay_us);
-    return request_ExtPack_SRAM_data(unit);
+ext_pack_error_t write_ExtPack_SRAM_data_to_address(unit_t unit, uint32_t address, uint8_t data, uint16_t command_timeout_us) {
+    // Address and data as one transaction --> Commands of custom ISRs can not change the address in between
+    ext_pack_command_t commands[SRAM_ADDRESS_COMMANDS + 1];
+    fill_ExtPack_SRAM_address_commands(unit, address, commands);
+    commands[SRAM_ADDRESS_COMMANDS] = (ext_pack_command_t){ _set_ExtPack_access_mode(unit, 0b11), data };
+    return send_transaction_to_ExtPack(commands, SRAM_ADDRESS_COMMANDS + 1, command_timeout_us);
+}
+
+ext_pack_error_t request_ExtPack_SRAM_data_from_address(unit_t unit, uint32_t address, uint16_t command_timeout_us) {
+    ext_pack_command_t commands[SRAM_ADDRESS_COMMANDS + 1];
+    fill_ExtPack_SRAM_address_commands(unit, address, commands);
+    commands[SRAM_ADDRESS_COMMANDS] = (ext_pack_command_t){ _set_ExtPack_access_mode(unit, 0b10), 0x00 };
+    return send_transaction_to_ExtPack(commands, SRAM_ADDRESS_COMMANDS + 1, command_timeout_us);
 }
 
 ext_pack_error_t read_ExtPack_SRAM_data(unit_t unit, uint8_t* recv_data, uint16_t timeout_us) {
-    for (uint16_t i = 0; i < timeout_us; i++) {
-        _delay_us(1);
-        if (get_ExtPack_event(unit)) {
-            clear_ExtPack_event(unit);
-            *recv_data = unit_data[unit].input_values;
-            return EXT_PACK_SUCCESS;
-        }
+    if (wait_for_ExtPack_event(unit, timeout_us) == EXT_PACK_FAILURE) {
+        // Timeout exceeded
+        return EXT_PACK_FAILURE;
     }
-    // Timeout exceeded
-    return EXT_PACK_FAILURE;
+    clear_ExtPack_event(unit);
+    *recv_data = get_ExtPack_stored_unit_input_values(unit);
+    return EXT_PACK_SUCCESS;
 }
 
-uint8_t read_ExtPack_SRAM_data_from_address(unit_t unit, uint32_t address, uint8_t* recv_data, uint16_t send_byte_delay_us, uint16_t timeout_us) {
-    if (set_ExtPack_SRAM_address(unit, address, send_byte_delay_us) == EXT_PACK_FAILURE) {
+uint8_t read_ExtPack_SRAM_data_from_address(unit_t unit, uint32_t address, uint8_t* recv_data, uint16_t command_timeout_us, uint16_t timeout_us) {
+    if (request_ExtPack_SRAM_data_from_address(unit, address, command_timeout_us) == EXT_PACK_FAILURE) {
         return EXT_PACK_FAILURE;
     }
-    delay_us(send_byte_delay_us);
     return read_ExtPack_SRAM_data(unit, recv_data, timeout_us);
 }
\ No newline at end of file
@@ -6,7 +6,9 @@
  * @layer Service
  *
  * @details This header provides blocking and non-blocking functions for accessing SRAM via ExtPack.
- * Includes address setting, reading and writing data with optional delays and timeout handling.
+ * Includes address setting, reading and writing data with send buffer and read timeouts.
+ * Address and command are queued as one transaction (see send_transaction_to_ExtPack), so commands of custom ISRs can not get in between.
+ * With EXT_PACK_SLEEP_WAIT = 1 the controller sleeps while waiting for the read data (see wait_for_ExtPack_event()).
  *
  * ## Provided Functions:
  * - set_ExtPack_SRAM_address: Set the address for a SRAM unit.
@@ -37,10 +39,10 @@
  *
  * @param unit The SRAM unit of ExtPack to set the address for.
  * @param address The address to set. (Only uses the lower 19 bit)
- * @param send_byte_delay_us The delay between sending two bytes in us.
+ * @param command_timeout_us The maximum time in us to wait for space in the send buffer per command of the transaction (no delay between the bytes).
  * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on failure.
  */
-ext_pack_error_t set_ExtPack_SRAM_address(unit_t unit, uint32_t address, uint16_t send_byte_delay_us);
+ext_pack_error_t set_ExtPack_SRAM_address(unit_t unit, uint32_t address, uint16_t command_timeout_us);
 
 /**
  * @brief Sets the address for the SRAM unit and writes the data to it.
@@ -50,10 +52,10 @@ ext_pack_error_t set_ExtPack_SRAM_address(unit_t unit, uint32_t address, uint16_
  * @param unit The SRAM unit of ExtPack to set the address for and write the data to.
  * @param address The address to set and write the data to. (Only uses the lower 19 bit)
  * @param data The data to write.
- * @param send_byte_delay_us The delay between sending two bytes in us.
+ * @param command_timeout_us The maximum time in us to wait for space in the send buffer per command of the transaction (no delay between the bytes).
  * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on failure.
  */
-ext_pack_error_t write_ExtPack_SRAM_data_to_address(unit_t unit, uint32_t address, uint8_t data, uint16_t send_byte_delay_us);
+ext_pack_error_t write_ExtPack_SRAM_data_to_address(unit_t unit, uint32_t address, uint8_t data, uint16_t command_timeout_us);
 
 /**
  * @brief Request the data at the address from the SRAM.
@@ -63,10 +65,10 @@ ext_pack_error_t write_ExtPack_SRAM_data_to_address(unit_t unit, uint32_t addres
  *
  * @param unit The SRAM unit to request the data from.
  * @param address The address of the data to request. (Only uses the lower 19 bit)
- * @param send_byte_delay_us The delay between sending two bytes in us.
+ * @param command_timeout_us The maximum time in us to wait for space in the send buffer per command of the transaction (no delay between the bytes).
  * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on failure.
  */
-ext_pack_error_t request_ExtPack_SRAM_data_from_address(unit_t unit, uint32_t address, uint16_t send_byte_delay_us);
+ext_pack_error_t request_ExtPack_SRAM_data_from_address(unit_t unit, uint32_t address, uint16_t command_timeout_us);
 
 /**
  * @brief Reads the data at the address from the SRAM unit.
@@ -78,11 +80,11 @@ ext_pack_error_t request_ExtPack_SRAM_data_from_address(unit_t unit, uint32_t ad
  * @param unit The SRAM unit to read the data from.
  * @param address The address to read the data from.
  * @param recv_data Pointer to store the received data to.
- * @param send_byte_delay_us The delay between sending two bytes in us.
+ * @param command_timeout_us The maximum time in us to wait for space in the send buffer per command of the transaction (no delay between the bytes).
  * @param timeout_us The maximum time to wait for the data in us.
  * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on failure.
  */
-uint8_t read_ExtPack_SRAM_data_from_address(unit_t unit, uint32_t address, uint8_t* recv_data, uint16_t send_byte_delay_us, uint16_t timeout_us);
+uint8_t read_ExtPack_SRAM_data_from_address(unit_t unit, uint32_t address, uint8_t* recv_data, uint16_t command_timeout_us, uint16_t timeout_us);
 
 /**
  * @brief Reads the data from the SRAM unit of the previously set address.
@@ -1,23 +1,23 @@
 #include "ExtPack_U_Timer_Advanced.h"
-#include "../Util/Dynamic_Delay.h"
+#include "ExtPack_Advanced.h"
 
 ext_pack_error_t configure_ExtPack_timer(unit_t unit, uint8_t prescaler_divisor, uint8_t start_value) {
-    uint8_t send_delay_us = get_ExtPack_send_duration_us();
-    if(set_ExtPack_timer_enable(unit, 0) == EXT_PACK_FAILURE) {
+    // One transaction --> The timer never runs with a partial configuration of commands of custom ISRs in between
+    const ext_pack_command_t commands[] = {
+        { _set_ExtPack_access_mode(unit, 0b00), 0 },                  // Disable
+        { _set_ExtPack_access_mode(unit, 0b10), prescaler_divisor },
+        { _set_ExtPack_access_mode(unit, 0b11), start_value },
+        { _set_ExtPack_access_mode(unit, 0b01), 0x00 },               // Restart
+        { _set_ExtPack_access_mode(unit, 0b00), 1 }                   // Enable
+    };
+    if (send_transaction_to_ExtPack(commands, sizeof(commands) / sizeof(commands[0]), get_ExtPack_send_duration_us()) == EXT_PACK_FAILURE) {
         return EXT_PACK_FAILURE;
     }
-    delay_us(send_delay_us);
-    if(set_ExtPack_timer_prescaler(unit, prescaler_divisor) == EXT_PACK_FAILURE) {
-        return EXT_PACK_FAILURE;
-    }
-    delay_us(send_delay_us);
-    if(set_ExtPack_timer_start_value(unit, start_value) == EXT_PACK_FAILURE) {
-        return EXT_PACK_FAILURE;
-    }
-    delay_us(send_delay_us);
-    if(restart_ExtPack_timer(unit) == EXT_PACK_FAILURE) {
-        return EXT_PACK_FAILURE;
-    }
-    delay_us(send_delay_us);
-    return set_ExtPack_timer_enable(unit, 1);
-}
\ No newline at end of file
+    // Always sent completely (the restart needs the start value), only the shadow state is updated
+    uint8_t interrupt_state = enter_critical_zone();
+    _update_ExtPack_configuration(commands[1].unit, prescaler_divisor);
+    _update_ExtPack_configuration(commands[2].unit, start_value);
+    _update_ExtPack_configuration(commands[4].unit, 1);
+    exit_critical_zone(interrupt_state);
+    return EXT_PACK_SUCCESS;
+}
@@ -32,6 +32,8 @@
  *
  * @layer Service
  *
+ * @note Sent as one transaction (see send_transaction_to_ExtPack), commands of custom ISRs can not get in between.
+ *
  * @param unit The Timer unit of ExtPack which to configure.
  * @param prescaler_divisor The prescaler divisor value to be applied.
  * @param start_value The start value to be applied.
@@ -5,11 +5,13 @@
  *
  * @layer Service
  *
- * @details This header provides a wrapper function for sending null-terminated strings over UART
- * with optional delay between bytes.
+ * @details This header provides wrapper functions for sending null-terminated strings over UART
+ * with optional delay between bytes and binary buffers at full link rate.
  *
  * ## Provided Functions:
  * - send_ExtPack_UART_String: Sends a string over UART with delay, aborts on failure.
+ * - send_ExtPack_UART_buffer: Sends a binary buffer over UART.
+ * - start_ExtPack_UART_paced_send: Sends a buffer over UART in the background, paced for the baud rate of the partner.
  *
  * @author Markus Remy
  * @date 04.08.2025
@@ -20,6 +22,7 @@
 
 #include "../Util/ExtPack_U_UART.h"
 #include "ExtPack_Advanced.h"
+#include "../Core/ExtPack_Paced_Send.h"
 
 /**
  * @defgroup UART_Unit UART Unit
@@ -44,6 +47,41 @@ static inline ext_pack_error_t send_ExtPack_UART_String(unit_t unit, const uint8
     return send_String_to_ExtPack(unit, data, send_byte_delay_us);
 }
 
+/**
+ * @brief Sends len bytes of the given buffer to the specified UART unit of ExtPack.
+ *
+ * @layer Service
+ *
+ * @param unit The ExtPack unit to which the data should be sent.
+ * @param buf The data to be sent (may contain '\0').
+ * @param len The amount of bytes to send.
+ * @param timeout_us The maximum time in us to wait for space in the send buffer (see send_buffer_to_ExtPack()).
+ * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on failure.
+ */
+static inline ext_pack_error_t send_ExtPack_UART_buffer(unit_t unit, const uint8_t* buf, uint16_t len, uint16_t timeout_us) {
+    return send_buffer_to_ExtPack(unit, buf, len, timeout_us);
+}
+
+/**
+ * @brief Starts sending len bytes of the given buffer to the specified UART unit of ExtPack without blocking.
+ *
+ * @details The bytes are paced so the UART of the unit with the given baud rate is not overrun.
+ * The paced send event of the unit is set when all bytes are in the send buffer (see ExtPack_Paced_Send.h).
+ *
+ * @layer Service
+ *
+ * @warning The buffer is not copied. It has to stay valid until the paced send event of the unit is set.
+ *
+ * @param unit The ExtPack unit to which the data should be sent.
+ * @param buf The data to be sent (may contain '\0').
+ * @param len The amount of bytes to send.
+ * @param baud_rate The baud rate of the UART of the unit.
+ * @return EXT_PACK_SUCCESS if started, EXT_PACK_FAILURE otherwise (see start_ExtPack_paced_send()).
+ */
+static inline ext_pack_error_t start_ExtPack_UART_paced_send(unit_t unit, const uint8_t* buf, uint16_t len, uint32_t baud_rate) {
+    return start_ExtPack_paced_send(unit, buf, len, get_ExtPack_pace_gap_us(baud_rate));
+}
+
 /** @} */
 
 #endif //EXTPACK_U_UART_ADVANCED_H
\ No newline at end of file
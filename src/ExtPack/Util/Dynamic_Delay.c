@@ -1,14 +1,25 @@
 #include "Dynamic_Delay.h"
+#include "../Core/ExtPack_Timebase.h"
 #include <util/delay.h>
 
 void delay_us(unsigned int __us) {
+    if (is_ExtPack_timebase_running()) {
+        ext_pack_deadline_t deadline = get_ExtPack_deadline(__us);
+        while (!is_ExtPack_deadline_expired(&deadline));
+        return;
+    }
     for (volatile unsigned int i = 0; i < __us; i++) {
         _delay_us(1);
     }
 }
 
 void delay_ms(unsigned int __ms) {
+    if (is_ExtPack_timebase_running()) {
+        ext_pack_deadline_t deadline = get_ExtPack_deadline(__ms * 1000UL);
+        while (!is_ExtPack_deadline_expired(&deadline));
+        return;
+    }
     for (volatile unsigned int i = 0; i < __ms; i++) {
         _delay_ms(1);
     }
-}
\ No newline at end of file
+}
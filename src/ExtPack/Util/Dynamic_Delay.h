@@ -5,8 +5,9 @@
  *
  * @layer Util
  *
- * @details This file provides busy-wait delay functions using _delay_us and _delay_ms
- * for dynamically customizable microsecond and millisecond delays.
+ * @details This file provides busy-wait delay functions for dynamically customizable microsecond and millisecond delays.
+ * While the microsecond clock runs (EXT_PACK_TIMEBASE = 1 after init_ExtPack(), see ExtPack_Timebase.h) they wait for a deadline of it.
+ * Otherwise (p.ex. before init_ExtPack()) they use _delay_us and _delay_ms.
  *
  * ## Features:
  * - delay_us: busy waits for a specified number of microseconds.
@@ -23,7 +24,8 @@
 
 /**
  * @brief Delays for approximately the given time through busy waiting.
- * Calls _delay_us(1) for delay_us times to bypass the problem to have compile-time constant values for _delay_us.
+ * Waits for a deadline of the microsecond clock while it runs
+ * or calls _delay_us(1) for delay_us times to bypass the problem to have compile-time constant values for _delay_us.
  *
  * @layer Util
  *
@@ -33,7 +35,8 @@ void delay_us(unsigned int delay_us);
 
 /**
  * @brief Delays for approximately the given time through busy waiting.
- * Calls _delay_ms(1) for delay_ms times to bypass the problem to have compile-time constant values for _delay_ms.
+ * Waits for a deadline of the microsecond clock while it runs
+ * or calls _delay_ms(1) for delay_ms times to bypass the problem to have compile-time constant values for _delay_ms.
  *
  * @layer Util
  *
@@ -22,6 +22,6 @@ uint8_t get_ExtPack_ack_data() {
 }
 
 ext_pack_error_t set_ExtPack_ACK_enable(uint8_t enable) {
-    unit_data[unit_U02].output_values = enable;
-    return _send_to_ExtPack(_set_ExtPack_access_mode(unit_U02, 00), enable);
+    get_ExtPack_unit_data(unit_U02)->output_values = enable;
+    return _send_configuration_to_ExtPack(_set_ExtPack_access_mode(unit_U02, 0b00), enable);
 }
\ No newline at end of file
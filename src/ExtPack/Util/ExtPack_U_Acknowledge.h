@@ -70,6 +70,7 @@ uint8_t get_ExtPack_ack_data();
  * @layer Util
  *
  * @note This request message is acknowledged by the ExtPack.
+ * @note Replaces the value queued by the previous write instead of sending the stale one with EXT_PACK_TX_COALESCING = 1 (see _send_coalesced_to_ExtPack()).
  *
  * @param enable Enable (>=1) or Disable (0) the unit.
  * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on failure.
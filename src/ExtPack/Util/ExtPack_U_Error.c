@@ -2,5 +2,5 @@
 #include "../Core/ExtPack_Internal.h"
 
 error_unit_error_type_t get_ExtPack_error() {
-    return unit_data[unit_U01].input_values;
+    return get_ExtPack_stored_unit_input_values(unit_U01);
 }
\ No newline at end of file
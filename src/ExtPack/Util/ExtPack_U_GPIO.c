@@ -10,6 +10,6 @@ uint8_t get_ExtPack_data_gpio_out(unit_t unit) {
 }
 
 ext_pack_error_t set_ExtPack_gpio_out(unit_t unit, uint8_t data) {
-    unit_data[unit].output_values = data; // Save set data locally
-    return _send_to_ExtPack(_set_ExtPack_access_mode(unit, 00), data);
+    get_ExtPack_unit_data(unit)->output_values = data; // Save set data locally
+    return _send_configuration_to_ExtPack(_set_ExtPack_access_mode(unit, 0b00), data); // Only the newest output values matter
 }
\ No newline at end of file
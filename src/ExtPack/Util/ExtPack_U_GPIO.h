@@ -67,6 +67,8 @@ uint8_t get_ExtPack_data_gpio_out(unit_t unit);
  *
  * @layer Util
  *
+ * @note Replaces the value queued by the previous write instead of sending the stale one with EXT_PACK_TX_COALESCING = 1 (see _send_coalesced_to_ExtPack()).
+ *
  * @param unit The unit to set the GPIO pins for.
  * @param data The GPIO pin register value to set.
  * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on failure.
@@ -10,6 +10,6 @@ uint8_t get_ExtPack_data_I2C_last_received_data(unit_t unit) {
 }
 
 ext_pack_error_t set_ExtPack_I2C_partner_adr(unit_t unit, uint8_t slave_id) {
-    unit_data[unit].output_values = slave_id; // Save slave_id locally
-    return _send_to_ExtPack(_set_ExtPack_access_mode(unit, 01), slave_id);
+    get_ExtPack_unit_data(unit)->output_values = slave_id; // Save slave_id locally
+    return _send_configuration_to_ExtPack(_set_ExtPack_access_mode(unit, 0b01), slave_id);
 }
\ No newline at end of file
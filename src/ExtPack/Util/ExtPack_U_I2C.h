@@ -12,6 +12,7 @@
  * - Request and receive a byte from the current or specified partner using receive_ExtPack_I2C_data and receive_ExtPack_I2C_data_from_partner.
  * - Send a byte via I2C using send_ExtPack_I2C_data.
  * - Send null-terminated strings with retry support using send_ExtPack_I2C_String and send_ExtPack_I2C_String_to_partner.
+ * - Skip setting the already set partner address with EXT_PACK_SHADOW_STATE = 1 (see _send_configuration_to_ExtPack()).
  *
  * @author Markus Remy
  * @date 17.06.2025
@@ -35,6 +35,7 @@
  * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on failure.
  */
 static inline ext_pack_error_t reset_ExtPack() {
+    invalidate_ExtPack_configuration(); // The ExtPack loses its configuration
     return _send_to_ExtPack(unit_U00, 0xFF);
 }
 
@@ -11,6 +11,7 @@
  * - Send data to a specific slave with send_ExtPack_SPI_data_to_slave.
  * - Send null-terminated strings with retry support using send_ExtPack_SPI_String and send_ExtPack_SPI_String_to_slave.
  * - Retrieve the last set SPI slave id with get_ExtPack_data_SPI_current_slave.
+ * - Skip selecting the already selected slave with EXT_PACK_SHADOW_STATE = 1 (see _send_configuration_to_ExtPack()).
  *
  * @author Markus Remy
  * @date 17.06.2025
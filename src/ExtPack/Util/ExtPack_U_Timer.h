@@ -11,6 +11,7 @@
  * - Set the prescaler divisor with set_ExtPack_timer_prescaler.
  * - Set the start value with set_ExtPack_timer_start_value.
  * - Configure, restart, and enable a Timer unit with configure_ExtPack_timer.
+ * - Skip unchanged enable, prescaler and start values with EXT_PACK_SHADOW_STATE = 1 (see _send_configuration_to_ExtPack()).
  *
  * @author Markus Remy
  * @date 17.06.2025
@@ -37,7 +38,7 @@
  * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on failure.
  */
 static inline ext_pack_error_t set_ExtPack_timer_enable(unit_t unit, uint8_t enable) {
-    return _send_to_ExtPack(_set_ExtPack_access_mode(unit, 00), enable);
+    return _send_configuration_to_ExtPack(_set_ExtPack_access_mode(unit, 0b00), enable);
 }
 
 /**
@@ -62,7 +63,7 @@ static inline ext_pack_error_t restart_ExtPack_timer(unit_t unit) {
  * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on failure.
  */
 static inline ext_pack_error_t set_ExtPack_timer_prescaler(unit_t unit, uint8_t prescaler_divisor) {
-    return _send_to_ExtPack(_set_ExtPack_access_mode(unit, 10), prescaler_divisor);
+    return _send_configuration_to_ExtPack(_set_ExtPack_access_mode(unit, 0b10), prescaler_divisor);
 }
 
 /**
@@ -75,7 +76,7 @@ static inline ext_pack_error_t set_ExtPack_timer_prescaler(unit_t unit, uint8_t
  * @return EXT_PACK_SUCCESS on success, EXT_PACK_FAILURE on failure.
  */
 static inline ext_pack_error_t set_ExtPack_timer_start_value(unit_t unit, uint8_t start_value) {
-    return _send_to_ExtPack(_set_ExtPack_access_mode(unit, 11), start_value);
+    return _send_configuration_to_ExtPack(_set_ExtPack_access_mode(unit, 0b11), start_value);
 }
 
 /** @} */
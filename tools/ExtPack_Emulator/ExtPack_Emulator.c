@@ -0,0 +1,283 @@
+#include "ExtPack_Emulator.h"
+#include "ExtPack/Util/ExtPack_U_Error.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Queues a response sorted by its due time.
+ * Responses with the same due time keep their order.
+ */
+static void queue_response(ext_pack_emu_t* emu, uint64_t due_us, unit_t unit, uint8_t data) {
+    if (emu->amount_responses == EXT_PACK_EMU_RESPONSE_QUEUE_LEN) {
+        emu->stats.responses_dropped++;
+        return;
+    }
+    uint16_t index = emu->amount_responses;
+    while (index > 0 && emu->responses[index - 1].due_us > due_us) {
+        emu->responses[index] = emu->responses[index - 1];
+        index--;
+    }
+    emu->responses[index].due_us = due_us;
+    emu->responses[index].unit = unit;
+    emu->responses[index].data = data;
+    emu->amount_responses++;
+}
+
+static void queue_error(ext_pack_emu_t* emu, uint64_t now_us, error_unit_error_type_t error) {
+    emu->stats.errors_sent++;
+    queue_response(emu, now_us + emu->config[unit_U01].latency_us, unit_U01, error);
+}
+
+static uint64_t get_timer_period_us(const ext_pack_emu_t* emu, const ext_pack_emu_unit_state_t* state) {
+    uint64_t prescaler = state->timer_prescaler > 0 ? state->timer_prescaler : 1;
+    return (prescaler * (256 - state->timer_start_value) * 1000000ULL) / emu->timer_clock_hz;
+}
+
+static void reset_unit_states(ext_pack_emu_t* emu) {
+    emu->ack_enabled = 0;
+    emu->unit_byte_received = 0;
+    emu->amount_responses = 0;
+    for (uint8_t unit = 0; unit < 64; unit++) {
+        ext_pack_emu_unit_state_t* state = &emu->state[unit];
+        state->output_values = 0;
+        state->timer_enabled = 0;
+        state->timer_prescaler = 0;
+        state->timer_start_value = 0;
+        state->i2c_next_is_pointer = 1;
+        memset(state->i2c_pointer, 0, sizeof(state->i2c_pointer));
+        state->sram_address = 0;
+        state->sram_address_byte = 0;
+    }
+}
+
+void init_ExtPack_emu(ext_pack_emu_t* emu, void (*send)(unit_t, uint8_t, void*), void* send_context) {
+    memset(emu, 0, sizeof(*emu));
+    emu->send = send;
+    emu->send_context = send_context;
+    emu->timer_clock_hz = EXT_PACK_EMU_DEFAULT_TIMER_CLOCK_HZ;
+    emu->resync_timeout_us = EXT_PACK_EMU_DEFAULT_RESYNC_TIMEOUT_US;
+    configure_ExtPack_emu_unit(emu, unit_U00, EXTPACK_RESET_UNIT, 0);
+    configure_ExtPack_emu_unit(emu, unit_U01, EXTPACK_ERROR_UNIT, 0);
+    configure_ExtPack_emu_unit(emu, unit_U02, EXTPACK_ACK_UNIT, 0);
+    reset_unit_states(emu);
+}
+
+void free_ExtPack_emu(ext_pack_emu_t* emu) {
+    for (uint8_t unit = 0; unit < 64; unit++) {
+        free(emu->state[unit].i2c_registers);
+        free(emu->state[unit].sram);
+        emu->state[unit].i2c_registers = NULL;
+        emu->state[unit].sram = NULL;
+    }
+}
+
+uint8_t configure_ExtPack_emu_unit(ext_pack_emu_t* emu, unit_t unit, unit_type_t unit_type, uint32_t latency_us) {
+    if (unit > unit_U63 || unit_type > EXTPACK_SRAM_UNIT) {
+        return 1;
+    }
+    ext_pack_emu_unit_state_t* state = &emu->state[unit];
+    if (unit_type == EXTPACK_I2C_UNIT && state->i2c_registers == NULL) {
+        state->i2c_registers = calloc(128 * 256, 1);
+        if (state->i2c_registers == NULL) {
+            return 1;
+        }
+    }
+    if (unit_type == EXTPACK_SRAM_UNIT && state->sram == NULL) {
+        state->sram = calloc(EXT_PACK_EMU_SRAM_SIZE, 1);
+        if (state->sram == NULL) {
+            return 1;
+        }
+    }
+    emu->config[unit].unit_type = unit_type;
+    emu->config[unit].latency_us = latency_us;
+    return 0;
+}
+
+void reset_ExtPack_emu(ext_pack_emu_t* emu, uint64_t now_us) {
+    reset_unit_states(emu);
+    queue_response(emu, now_us + emu->config[unit_U00].latency_us, unit_U00, 0xFF);
+}
+
+/*
+ * Executes a complete command pair.
+ * Returns 0 if the command is valid, 1 otherwise.
+ */
+static uint8_t process_command(ext_pack_emu_t* emu, unit_t unit, uint8_t access_mode, uint8_t data, uint64_t now_us) {
+    ext_pack_emu_unit_state_t* state = &emu->state[unit];
+    uint64_t due_us = now_us + emu->config[unit].latency_us;
+    switch (emu->config[unit].unit_type) {
+        case EXTPACK_RESET_UNIT:
+            if (access_mode != 0b00 || data != 0xFF) {
+                return 1;
+            }
+            reset_ExtPack_emu(emu, now_us);
+            return 0;
+        case EXTPACK_ACK_UNIT:
+            if (access_mode != 0b00) {
+                return 1;
+            }
+            emu->ack_enabled = data > 0;
+            return 0;
+        case EXTPACK_GPIO_UNIT:
+            if (access_mode == 0b00) {
+                state->output_values = data;
+            } else if (access_mode == 0b01) {
+                // Outputs are connected to the inputs
+                queue_response(emu, due_us, unit, state->output_values);
+            } else {
+                return 1;
+            }
+            return 0;
+        case EXTPACK_UART_UNIT:
+            if (access_mode != 0b00) {
+                return 1;
+            }
+            // RX is connected to TX
+            queue_response(emu, due_us, unit, data);
+            return 0;
+        case EXTPACK_TIMER_UNIT:
+            switch (access_mode) {
+                case 0b00:
+                    if (data > 0 && !state->timer_enabled) {
+                        state->timer_next_event_us = due_us + get_timer_period_us(emu, state);
+                    }
+                    state->timer_enabled = data > 0;
+                    break;
+                case 0b01:
+                    state->timer_next_event_us = due_us + get_timer_period_us(emu, state);
+                    break;
+                case 0b10:
+                    state->timer_prescaler = data;
+                    break;
+                default:
+                    state->timer_start_value = data;
+            }
+            return 0;
+        case EXTPACK_SPI_UNIT:
+            if (access_mode == 0b00) {
+                // MISO is connected to MOSI
+                queue_response(emu, due_us, unit, data);
+            } else if (access_mode == 0b01) {
+                state->output_values = data;
+            } else {
+                return 1;
+            }
+            return 0;
+        case EXTPACK_I2C_UNIT: {
+            uint8_t partner = state->output_values & 0x7F;
+            uint8_t* registers = &state->i2c_registers[partner * 256];
+            if (access_mode == 0b00) {
+                if (state->i2c_next_is_pointer) {
+                    state->i2c_pointer[partner] = data;
+                    state->i2c_next_is_pointer = 0;
+                } else {
+                    registers[state->i2c_pointer[partner]++] = data;
+                }
+            } else if (access_mode == 0b01) {
+                state->output_values = data;
+                state->i2c_next_is_pointer = 1;
+            } else if (access_mode == 0b10) {
+                queue_response(emu, due_us, unit, registers[state->i2c_pointer[partner]++]);
+                state->i2c_next_is_pointer = 1;
+            } else {
+                return 1;
+            }
+            return 0;
+        }
+        case EXTPACK_SRAM_UNIT:
+            switch (access_mode) {
+                case 0b00:
+                    state->sram_address = 0;
+                    state->sram_address_byte = 0;
+                    break;
+                case 0b01:
+                    if (state->sram_address_byte < 4) {
+                        uint8_t shift = state->sram_address_byte++ * 8;
+                        state->sram_address = (state->sram_address & ~(0xFFUL << shift)) | ((uint32_t)data << shift);
+                    }
+                    break;
+                case 0b10:
+                    // Address stays valid, only the next address byte is reset to the LSB
+                    queue_response(emu, due_us, unit, state->sram[state->sram_address & (EXT_PACK_EMU_SRAM_SIZE - 1)]);
+                    state->sram_address_byte = 0;
+                    break;
+                default:
+                    state->sram[state->sram_address & (EXT_PACK_EMU_SRAM_SIZE - 1)] = data;
+                    state->sram_address_byte = 0;
+            }
+            return 0;
+        default:
+            // Undefined unit or unit which can not receive (Error unit)
+            return 1;
+    }
+}
+
+void feed_ExtPack_emu_byte(ext_pack_emu_t* emu, uint8_t byte, uint64_t now_us) {
+    poll_ExtPack_emu(emu, now_us); // Detects resync timeouts before the byte is used
+    if (!emu->unit_byte_received) {
+        emu->received_unit = byte;
+        emu->received_unit_us = now_us;
+        emu->unit_byte_received = 1;
+        return;
+    }
+    emu->unit_byte_received = 0;
+    unit_t unit = emu->received_unit & 0x3F;
+    uint8_t access_mode = emu->received_unit >> 6;
+    uint8_t ack_enabled = emu->ack_enabled;
+    if (process_command(emu, unit, access_mode, byte, now_us)) {
+        queue_error(emu, now_us, ERROR_UNIT_ERROR_PROCESSING);
+        return;
+    }
+    emu->stats.commands_received++;
+    if ((ack_enabled || emu->ack_enabled) && emu->config[unit].unit_type != EXTPACK_RESET_UNIT) {
+        // Every command is acknowledged with its data, also the one enabling the ACK unit
+        emu->stats.acks_sent++;
+        queue_response(emu, now_us + emu->config[unit_U02].latency_us, unit_U02, byte);
+    }
+}
+
+void poll_ExtPack_emu(ext_pack_emu_t* emu, uint64_t now_us) {
+    if (emu->unit_byte_received && now_us - emu->received_unit_us > emu->resync_timeout_us) {
+        // Data byte did not arrive in time
+        emu->unit_byte_received = 0;
+        emu->stats.resyncs++;
+        queue_error(emu, now_us, ERROR_UNIT_ERROR_RECEIVING_FROM_HOST);
+    }
+    for (uint8_t unit = 0; unit < 64; unit++) {
+        ext_pack_emu_unit_state_t* state = &emu->state[unit];
+        if (emu->config[unit].unit_type == EXTPACK_TIMER_UNIT && state->timer_enabled) {
+            uint64_t period_us = get_timer_period_us(emu, state);
+            while (state->timer_next_event_us <= now_us) {
+                queue_response(emu, state->timer_next_event_us, unit, 0x00);
+                state->timer_next_event_us += period_us > 0 ? period_us : 1;
+            }
+        }
+    }
+    uint16_t amount_due = 0;
+    while (amount_due < emu->amount_responses && emu->responses[amount_due].due_us <= now_us) {
+        emu->stats.commands_sent++;
+        emu->send(emu->responses[amount_due].unit, emu->responses[amount_due].data, emu->send_context);
+        amount_due++;
+    }
+    if (amount_due > 0) {
+        emu->amount_responses -= amount_due;
+        memmove(emu->responses, emu->responses + amount_due, emu->amount_responses * sizeof(ext_pack_emu_response_t));
+    }
+}
+
+uint64_t get_ExtPack_emu_next_due_us(const ext_pack_emu_t* emu) {
+    uint64_t next_due_us = UINT64_MAX;
+    if (emu->amount_responses > 0) {
+        next_due_us = emu->responses[0].due_us;
+    }
+    if (emu->unit_byte_received && emu->received_unit_us + emu->resync_timeout_us + 1 < next_due_us) {
+        next_due_us = emu->received_unit_us + emu->resync_timeout_us + 1;
+    }
+    for (uint8_t unit = 0; unit < 64; unit++) {
+        if (emu->config[unit].unit_type == EXTPACK_TIMER_UNIT && emu->state[unit].timer_enabled
+            && emu->state[unit].timer_next_event_us < next_due_us) {
+            next_due_us = emu->state[unit].timer_next_event_us;
+        }
+    }
+    return next_due_us;
+}
@@ -0,0 +1,198 @@
+/**
+ * @file ExtPack_Emulator.h
+ *
+ * @brief Software emulation of the UART Extension Pack device.
+ *
+ * @details This library emulates the ExtPack side of the UART link.
+ * It speaks the same 2-byte unit/data framing as the HAL implementations (ExtPack_LL_*.c)
+ * and implements the Reset, Error, ACK, GPIO, UART, Timer, SPI, I2C and SRAM units.
+ * Every unit answers after a configurable latency.
+ *
+ * The library does not know any clock or device.
+ * The caller passes the current time in us and gets all bytes to send through a callback.
+ * See ExtPack_Emulator_Daemon.c for an emulator on the other end of a pty pair.
+ *
+ * ## Unit behaviour:
+ * - Reset: (U00, 0xFF) resets the emulated device which answers with (U00, 0xFF).
+ * - Error: Invalid commands and incomplete command pairs are reported with the ERROR_UNIT_ERROR_<TYPE> values.
+ * - ACK: When enabled, every received command is acknowledged with its data byte.
+ * - GPIO: Outputs are looped back to the inputs.
+ * - UART: Sent bytes are looped back (RX connected to TX).
+ * - Timer: Sends (unit, 0x00) every prescaler * (256 - start value) timer clock cycles.
+ * - SPI: Sent bytes are looped back (MISO connected to MOSI).
+ * - I2C: Every partner is a register file with an auto incrementing register pointer (like a DS3231).
+ *        The first byte written after setting the partner or after a read sets the register pointer.
+ * - SRAM: 512 KiB (19 bit address) memory.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#ifndef EXTPACK_EMULATOR_H
+#define EXTPACK_EMULATOR_H
+
+#include <stdint.h>
+#include "ExtPack/Core/ExtPack_Defs.h"
+
+/**
+ * @def EXT_PACK_EMU_RESPONSE_QUEUE_LEN
+ * @brief Maximum amount of responses waiting for their latency to pass.
+ */
+#ifndef EXT_PACK_EMU_RESPONSE_QUEUE_LEN
+    #define EXT_PACK_EMU_RESPONSE_QUEUE_LEN 4096
+#endif
+
+/**
+ * @def EXT_PACK_EMU_SRAM_SIZE
+ * @brief Size of the emulated SRAM of every SRAM unit in bytes.
+ */
+#define EXT_PACK_EMU_SRAM_SIZE (1UL << 19)
+
+/**
+ * @def EXT_PACK_EMU_DEFAULT_TIMER_CLOCK_HZ
+ * @brief Input clock of the Timer units of the ExtPack in Hz.
+ */
+#define EXT_PACK_EMU_DEFAULT_TIMER_CLOCK_HZ 50000
+
+/**
+ * @def EXT_PACK_EMU_DEFAULT_RESYNC_TIMEOUT_US
+ * @brief Maximum time in us between the unit and the data byte of a command pair.
+ */
+#define EXT_PACK_EMU_DEFAULT_RESYNC_TIMEOUT_US 1000
+
+/**
+ * @brief Configuration of one emulated unit.
+ */
+typedef struct {
+    /**
+     * @brief Type of the unit (EXTPACK_<TYPE>_UNIT). EXTPACK_UNDEFINED if the unit does not exist.
+     */
+    unit_type_t unit_type;
+    /**
+     * @brief Time in us between receiving a command and sending the answer of the unit.
+     */
+    uint32_t latency_us;
+} ext_pack_emu_unit_config_t;
+
+/**
+ * @brief Statistics of the emulated device.
+ */
+typedef struct {
+    uint64_t commands_received;   /**< Received valid command pairs */
+    uint64_t commands_sent;       /**< Sent command pairs (responses, ACKs, errors, events) */
+    uint64_t acks_sent;           /**< Sent acknowledgements */
+    uint64_t errors_sent;         /**< Sent errors */
+    uint64_t resyncs;             /**< Incomplete command pairs dropped */
+    uint64_t responses_dropped;   /**< Responses dropped because the response queue was full */
+} ext_pack_emu_stats_t;
+
+/**
+ * @brief Response of a unit waiting for its latency to pass.
+ */
+typedef struct {
+    uint64_t due_us;    /**< Time the response is sent */
+    unit_t unit;        /**< Unit byte of the response */
+    uint8_t data;       /**< Data byte of the response */
+} ext_pack_emu_response_t;
+
+/**
+ * @brief State of one emulated unit.
+ */
+typedef struct {
+    uint8_t output_values;          /**< GPIO outputs, SPI slave or I2C partner */
+    uint8_t timer_enabled;          /**< Timer enable state */
+    uint8_t timer_prescaler;        /**< Timer prescaler divisor */
+    uint8_t timer_start_value;      /**< Timer start value */
+    uint64_t timer_next_event_us;   /**< Time of the next timer event */
+    uint8_t i2c_next_is_pointer;    /**< Next written I2C byte is the register pointer */
+    uint8_t i2c_pointer[128];       /**< Register pointer of every I2C partner */
+    uint8_t* i2c_registers;         /**< 128 partners * 256 registers */
+    uint32_t sram_address;          /**< Current SRAM address */
+    uint8_t sram_address_byte;      /**< Next SRAM address byte to set */
+    uint8_t* sram;                  /**< SRAM memory */
+} ext_pack_emu_unit_state_t;
+
+/**
+ * @brief Emulated ExtPack device.
+ *
+ * @note Initialize with init_ExtPack_emu() and release with free_ExtPack_emu().
+ */
+typedef struct {
+    ext_pack_emu_unit_config_t config[64];      /**< Configuration of all units */
+    ext_pack_emu_unit_state_t state[64];        /**< State of all units */
+    uint32_t timer_clock_hz;                    /**< Input clock of the Timer units */
+    uint32_t resync_timeout_us;                 /**< Maximum time between unit and data byte */
+    uint8_t ack_enabled;                        /**< ACK unit state */
+    uint8_t unit_byte_received;                 /**< A unit byte is waiting for its data byte */
+    unit_t received_unit;                       /**< The received unit byte */
+    uint64_t received_unit_us;                  /**< Receive time of the unit byte */
+    ext_pack_emu_response_t responses[EXT_PACK_EMU_RESPONSE_QUEUE_LEN]; /**< Responses sorted by due time */
+    uint16_t amount_responses;                  /**< Amount of waiting responses */
+    ext_pack_emu_stats_t stats;                 /**< Statistics */
+    void (*send)(unit_t unit, uint8_t data, void* context); /**< Sends a command pair to the host */
+    void* send_context;                         /**< Passed to send */
+} ext_pack_emu_t;
+
+/**
+ * @brief Initializes the emulated device with units U00 (Reset), U01 (Error) and U02 (ACK).
+ *
+ * @param emu The emulator to initialize.
+ * @param send Called for every command pair the device sends to the host.
+ * @param send_context Passed to send.
+ */
+void init_ExtPack_emu(ext_pack_emu_t* emu, void (*send)(unit_t, uint8_t, void*), void* send_context);
+
+/**
+ * @brief Releases the memory of the emulated device.
+ *
+ * @param emu The emulator to release.
+ */
+void free_ExtPack_emu(ext_pack_emu_t* emu);
+
+/**
+ * @brief Configures a unit of the emulated device.
+ *
+ * @param emu The emulator.
+ * @param unit The unit to configure.
+ * @param unit_type The type of the unit (EXTPACK_<TYPE>_UNIT).
+ * @param latency_us Time in us between receiving a command and sending the answer of the unit.
+ * @return 0 on success, 1 if the unit type is unknown or the memory could not be allocated.
+ */
+uint8_t configure_ExtPack_emu_unit(ext_pack_emu_t* emu, unit_t unit, unit_type_t unit_type, uint32_t latency_us);
+
+/**
+ * @brief Processes a byte received from the host.
+ *
+ * @param emu The emulator.
+ * @param byte The received byte.
+ * @param now_us The current time in us.
+ */
+void feed_ExtPack_emu_byte(ext_pack_emu_t* emu, uint8_t byte, uint64_t now_us);
+
+/**
+ * @brief Sends all responses and events which are due.
+ *
+ * @param emu The emulator.
+ * @param now_us The current time in us.
+ */
+void poll_ExtPack_emu(ext_pack_emu_t* emu, uint64_t now_us);
+
+/**
+ * @brief Returns the time the next response or event is due.
+ *
+ * @param emu The emulator.
+ * @return The time in us or UINT64_MAX if nothing is waiting.
+ */
+uint64_t get_ExtPack_emu_next_due_us(const ext_pack_emu_t* emu);
+
+/**
+ * @brief Resets the emulated device like a brown-out and sends the reset notification (U00, 0xFF).
+ *
+ * @details Unit configurations and the SRAM content are kept. All other state is lost.
+ *
+ * @param emu The emulator.
+ * @param now_us The current time in us.
+ */
+void reset_ExtPack_emu(ext_pack_emu_t* emu, uint64_t now_us);
+
+#endif //EXTPACK_EMULATOR_H
@@ -0,0 +1,234 @@
+/**
+ * @file ExtPack_Emulator_Daemon.c
+ *
+ * @brief Emulated ExtPack on the other end of a pty pair.
+ *
+ * @details Creates a pty pair and prints the path of the slave side.
+ * Use it as serial device of the host HAL (EXT_PACK_HOST_DEVICE=<path>) to run the library against the emulator.
+ * The sent bytes are paced with the configured BAUD rate (8N1) like on the real link.
+ *
+ * Usage:
+ * `ExtPack_Emulator [-b <baud>] [-t <timer clock Hz>] [-l <symlink>] [-u <unit>:<type>[:<latency us>]]...`
+ * - type: reset, error, ack, gpio, uart, timer, spi, i2c or sram
+ * - Units U00 (reset), U01 (error) and U02 (ack) are always configured.
+ *
+ * Signals:
+ * - SIGUSR1: Resets the emulated ExtPack like a brown-out.
+ * - SIGINT/SIGTERM: Prints the statistics and exits.
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "ExtPack_Emulator.h"
+
+/**
+ * @def OUT_QUEUE_LEN
+ * @brief Maximum amount of command pairs waiting for the link.
+ */
+#define OUT_QUEUE_LEN 8192
+
+/**
+ * @brief Command pair waiting to be sent over the paced link.
+ */
+typedef struct {
+    uint64_t send_at_us;    /**< Time the pair starts on the link */
+    uint8_t bytes[2];       /**< Unit and data byte */
+} out_pair_t;
+
+static out_pair_t out_queue[OUT_QUEUE_LEN];
+static uint16_t out_queue_read_index = 0;
+static uint16_t out_queue_amount = 0;
+static uint64_t link_free_us = 0;
+static uint32_t pair_duration_ns = 0;
+static uint64_t out_pairs_dropped = 0;
+
+static volatile sig_atomic_t reset_requested = 0;
+static volatile sig_atomic_t exit_requested = 0;
+
+static uint64_t now_us() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000ULL + now.tv_nsec / 1000;
+}
+
+/*
+ * Queues a pair on the paced link.
+ */
+static void send_pair(unit_t unit, uint8_t data, void* context) {
+    if (out_queue_amount == OUT_QUEUE_LEN) {
+        out_pairs_dropped++;
+        return;
+    }
+    uint64_t now = now_us();
+    uint64_t send_at_us = link_free_us > now ? link_free_us : now;
+    link_free_us = send_at_us + (pair_duration_ns + 999) / 1000;
+    out_pair_t* pair = &out_queue[(out_queue_read_index + out_queue_amount++) % OUT_QUEUE_LEN];
+    pair->send_at_us = send_at_us;
+    pair->bytes[0] = unit;
+    pair->bytes[1] = data;
+}
+
+static void handle_signal(int signal) {
+    if (signal == SIGUSR1) {
+        reset_requested = 1;
+    } else {
+        exit_requested = 1;
+    }
+}
+
+static int parse_unit_type(const char* name) {
+    const char* names[] = {"undefined", "reset", "error", "ack", "gpio", "uart", "timer", "spi", "i2c", "sram"};
+    for (int type = 0; type <= EXTPACK_SRAM_UNIT; type++) {
+        if (strcmp(name, names[type]) == 0) {
+            return type;
+        }
+    }
+    return -1;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr, "Usage: %s [-b <baud>] [-t <timer clock Hz>] [-l <symlink>] [-u <unit>:<type>[:<latency us>]]...\n", program);
+    fprintf(stderr, "  type: reset, error, ack, gpio, uart, timer, spi, i2c or sram\n");
+}
+
+int main(int argc, char** argv) {
+    static ext_pack_emu_t emu;
+    init_ExtPack_emu(&emu, send_pair, NULL);
+    uint32_t baud = 1000000;
+    const char* link_path = NULL;
+    int option;
+    while ((option = getopt(argc, argv, "b:t:l:u:h")) != -1) {
+        switch (option) {
+            case 'b':
+                baud = strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                emu.timer_clock_hz = strtoul(optarg, NULL, 0);
+                break;
+            case 'l':
+                link_path = optarg;
+                break;
+            case 'u': {
+                char type_name[16] = {0};
+                unsigned int unit;
+                unsigned long latency_us = 0;
+                int type;
+                if (sscanf(optarg, "%u:%15[a-z0-9]:%lu", &unit, type_name, &latency_us) < 2
+                    || (type = parse_unit_type(type_name)) < 0
+                    || configure_ExtPack_emu_unit(&emu, unit, type, latency_us)) {
+                    fprintf(stderr, "Invalid unit configuration: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            }
+            default:
+                usage(argv[0]);
+                return option == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    pair_duration_ns = baud > 0 ? (uint32_t)(20 * 1000000000ULL / baud) : 0;
+
+    // ---------- Create pty pair ----------
+    int master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master_fd < 0 || grantpt(master_fd) != 0 || unlockpt(master_fd) != 0) {
+        perror("Creating pty failed");
+        return EXIT_FAILURE;
+    }
+    fcntl(master_fd, F_SETFL, fcntl(master_fd, F_GETFL) | O_NONBLOCK); // A host not reading must not block the emulation
+    const char* slave_path = ptsname(master_fd);
+    // Keep the slave side open so the master does not hang up when the host closes it
+    int slave_fd = open(slave_path, O_RDWR | O_NOCTTY);
+    struct termios tty;
+    tcgetattr(slave_fd, &tty);
+    cfmakeraw(&tty);
+    tcsetattr(slave_fd, TCSANOW, &tty);
+    if (link_path != NULL) {
+        unlink(link_path);
+        if (symlink(slave_path, link_path) != 0) {
+            perror("Creating symlink failed");
+            return EXIT_FAILURE;
+        }
+    }
+    printf("%s\n", slave_path);
+    fflush(stdout);
+
+    struct sigaction action = {0};
+    action.sa_handler = handle_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    sigaction(SIGUSR1, &action, NULL);
+
+    // ---------- Emulation loop ----------
+    uint64_t start_us = now_us();
+    struct pollfd poll_fd = { .fd = master_fd, .events = POLLIN };
+    uint8_t bytes[256];
+    while (!exit_requested) {
+        if (reset_requested) {
+            reset_requested = 0;
+            reset_ExtPack_emu(&emu, now_us());
+        }
+        uint64_t now = now_us();
+        poll_ExtPack_emu(&emu, now);
+        // Send all pairs which are allowed on the link
+        while (out_queue_amount > 0 && out_queue[out_queue_read_index].send_at_us <= now) {
+            if (write(master_fd, out_queue[out_queue_read_index].bytes, 2) != 2) {
+                break; // pty full --> Retry later
+            }
+            out_queue_read_index = (out_queue_read_index + 1) % OUT_QUEUE_LEN;
+            out_queue_amount--;
+        }
+        // Sleep until the next byte arrives or something is due
+        uint64_t next_due_us = get_ExtPack_emu_next_due_us(&emu);
+        if (out_queue_amount > 0 && out_queue[out_queue_read_index].send_at_us < next_due_us) {
+            next_due_us = out_queue[out_queue_read_index].send_at_us;
+        }
+        struct timespec timeout = {0};
+        struct timespec* timeout_ptr = NULL;
+        if (next_due_us != UINT64_MAX) {
+            uint64_t wait_us = next_due_us > now ? next_due_us - now : 0;
+            timeout.tv_sec = wait_us / 1000000;
+            timeout.tv_nsec = (wait_us % 1000000) * 1000;
+            timeout_ptr = &timeout;
+        }
+        if (ppoll(&poll_fd, 1, timeout_ptr, NULL) > 0) {
+            if (poll_fd.revents & POLLIN) {
+                ssize_t amount_bytes = read(master_fd, bytes, sizeof(bytes));
+                now = now_us();
+                for (ssize_t i = 0; i < amount_bytes; i++) {
+                    feed_ExtPack_emu_byte(&emu, bytes[i], now);
+                }
+            } else {
+                usleep(1000); // No host connected
+            }
+        }
+    }
+
+    // ---------- Statistics ----------
+    double runtime_s = (now_us() - start_us) / 1000000.0;
+    fprintf(stderr, "Runtime:            %.3f s\n", runtime_s);
+    fprintf(stderr, "Commands received:  %llu (%.0f pairs/s)\n", (unsigned long long)emu.stats.commands_received, emu.stats.commands_received / runtime_s);
+    fprintf(stderr, "Commands sent:      %llu (%.0f pairs/s)\n", (unsigned long long)emu.stats.commands_sent, emu.stats.commands_sent / runtime_s);
+    fprintf(stderr, "ACKs sent:          %llu\n", (unsigned long long)emu.stats.acks_sent);
+    fprintf(stderr, "Errors sent:        %llu\n", (unsigned long long)emu.stats.errors_sent);
+    fprintf(stderr, "Resyncs:            %llu\n", (unsigned long long)emu.stats.resyncs);
+    fprintf(stderr, "Responses dropped:  %llu\n", (unsigned long long)(emu.stats.responses_dropped + out_pairs_dropped));
+    if (link_path != NULL) {
+        unlink(link_path);
+    }
+    close(slave_fd);
+    close(master_fd);
+    free_ExtPack_emu(&emu);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,266 @@
+/**
+ * @file ExtPack_Loadtest.c
+ *
+ * @brief Load test of the ExtPack library against the emulated ExtPack (host build).
+ *
+ * @details Measures the throughput of send_String_to_ExtPack, raw command pairs, send_buffer_to_ExtPack, the SRAM Advanced functions
+ * transactions, GPIO output bursts, ACK round trips (fixed and adaptive timeout) and pipelined acknowledged sends (EXT_PACK_TIMEBASE = 1). Paced sends (EXT_PACK_PACED_JOBS > 0) are checked for their gaps, flush_ExtPack_tx for the TX complete notification. At 1 MBaud the link allows 50k command pairs/s.
+ *
+ * Usage:
+ * 1) `ExtPack_Emulator -u 3:uart -u 4:gpio -u 8:sram` (prints the pty path)
+ * 2) `EXT_PACK_HOST_DEVICE=<pty path> ExtPack_Loadtest [amount commands]`
+ *
+ * @author Markus Remy
+ * @date 16.10.2026
+ */
+
+#define _GNU_SOURCE
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ExtPack/Core/ExtPack.h"
+#include "ExtPack/Core/ExtPack_Events.h"
+#include "ExtPack/Core/ExtPack_Link_Stats.h"
+#include "ExtPack/Core/ExtPack_Paced_Send.h"
+#include "ExtPack/Util/ExtPack_U_GPIO.h"
+#include "ExtPack/Service/ExtPack_U_UART_Advanced.h"
+#include "ExtPack/Service/ExtPack_U_SRAM_Advanced.h"
+#include "ExtPack/Service/ExtPack_U_Acknowledge_Advanced.h"
+#include "ExtPack/Service/ExtPack_Reliable_Send.h"
+
+#define UART_UNIT unit_U03
+#define GPIO_UNIT unit_U04
+#define SRAM_UNIT unit_U08
+
+volatile uint32_t uart_bytes_received = 0;
+volatile uint8_t tx_complete_notified = 0;
+#if EXT_PACK_RELIABLE_WINDOW > 0
+uint32_t reliable_acknowledged = 0;
+#endif
+
+static double now_s() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+void UART_unit_custom_ISR(unit_t unit, uint8_t data) {
+    uart_bytes_received++;
+}
+
+void tx_complete_callback() {
+    tx_complete_notified = 1;
+}
+
+#if EXT_PACK_RELIABLE_WINDOW > 0
+void reliable_completed(unit_t unit, uint8_t data, ext_pack_error_t result) {
+    reliable_acknowledged += result == EXT_PACK_SUCCESS;
+}
+#endif
+
+/*
+ * Waits until the expected amount of UART bytes is looped back or one second passed without progress.
+ */
+static void wait_for_uart_bytes(uint32_t expected) {
+    uint32_t last_received = 0;
+    double last_progress_s = now_s();
+    while (uart_bytes_received < expected && now_s() - last_progress_s < 1.0) {
+        dispatch_ExtPack_received(); // Only needed with RECV_BUF_LEN > 0
+        if (uart_bytes_received != last_received) {
+            last_received = uart_bytes_received;
+            last_progress_s = now_s();
+        }
+        usleep(100);
+    }
+}
+
+static void report(const char* name, uint32_t amount, uint32_t amount_ok, double duration_s, uint32_t pairs_per_operation) {
+    printf("%-28s %8u ops %8u ok %10.0f ops/s %10.0f pairs/s %8.2f us/op\n", name, amount, amount_ok,
+           amount / duration_s, amount * pairs_per_operation / duration_s, duration_s * 1e6 / amount);
+}
+
+int main(int argc, char** argv) {
+    uint32_t amount = argc > 1 ? strtoul(argv[1], NULL, 0) : 10000;
+    init_ExtPack(NULL, NULL, NULL);
+    init_ExtPack_Unit(UART_UNIT, EXTPACK_UART_UNIT, UART_unit_custom_ISR);
+    init_ExtPack_Unit(GPIO_UNIT, EXTPACK_GPIO_UNIT, NULL);
+    init_ExtPack_Unit(SRAM_UNIT, EXTPACK_SRAM_UNIT, NULL);
+
+    // ---------- send_String_to_ExtPack with the worst case send duration between bytes ----------
+    uint8_t string[33] = "0123456789abcdefghijklmnopqrstuv";
+    uint32_t amount_strings = (amount + 31) / 32;
+    uint32_t amount_ok = 0;
+#if EXT_PACK_LINK_STATS
+    ext_pack_link_stats_t stats;
+#endif
+    uart_bytes_received = 0;
+    double start_s = now_s();
+    for (uint32_t i = 0; i < amount_strings; i++) {
+        amount_ok += send_ExtPack_UART_String(UART_UNIT, string, get_ExtPack_send_duration_us()) == EXT_PACK_SUCCESS;
+        dispatch_ExtPack_received();
+    }
+    wait_for_uart_bytes(amount_strings * 32);
+    report("send_String_to_ExtPack", amount_strings * 32, uart_bytes_received, now_s() - start_s, 1);
+
+    // ---------- Raw command pairs, retried until the send buffer accepts them ----------
+    uart_bytes_received = 0;
+    start_s = now_s();
+    for (uint32_t i = 0; i < amount; i++) {
+        while (send_ExtPack_UART_data(UART_UNIT, (uint8_t)i) != EXT_PACK_SUCCESS);
+        dispatch_ExtPack_received();
+    }
+    wait_for_uart_bytes(amount);
+    report("_send_to_ExtPack (retry)", amount, uart_bytes_received, now_s() - start_s, 1);
+
+    // ---------- Binary buffers (containing zeros) with send_buffer_to_ExtPack ----------
+    uint8_t buffer[128];
+    for (uint8_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = i % 4 == 0 ? 0 : i;
+    }
+    uint32_t amount_buffers = (amount + sizeof(buffer) - 1) / sizeof(buffer);
+    amount_ok = 0;
+    uart_bytes_received = 0;
+    start_s = now_s();
+    for (uint32_t i = 0; i < amount_buffers; i++) {
+        amount_ok += send_ExtPack_UART_buffer(UART_UNIT, buffer, sizeof(buffer), 10000) == EXT_PACK_SUCCESS;
+        dispatch_ExtPack_received();
+    }
+    wait_for_uart_bytes(amount_buffers * sizeof(buffer));
+    report("send_buffer_to_ExtPack", amount_buffers * sizeof(buffer), uart_bytes_received, now_s() - start_s, 1);
+
+    // ---------- Flush after every buffer, the TX complete notification has to be called before the flush returns ----------
+    uint32_t amount_flush = (amount + 31) / 32;
+    amount_ok = 0;
+    uart_bytes_received = 0;
+    start_s = now_s();
+    for (uint32_t i = 0; i < amount_flush; i++) {
+        tx_complete_notified = 0;
+        send_ExtPack_UART_buffer(UART_UNIT, buffer, 32, 10000);
+        notify_ExtPack_tx_complete(tx_complete_callback);
+        amount_ok += flush_ExtPack_tx(10000) == EXT_PACK_SUCCESS && tx_complete_notified;
+        dispatch_ExtPack_received();
+    }
+    report("flush_ExtPack_tx", amount_flush, amount_ok, now_s() - start_s, 32);
+    wait_for_uart_bytes(amount_flush * 32);
+
+#if EXT_PACK_PACED_JOBS > 0
+    // ---------- Paced send (the main context only waits for the paced send event) ----------
+    uint16_t amount_paced = 64;
+    uint16_t paced_gap_us = 200;
+    uart_bytes_received = 0;
+    clear_ExtPack_paced_send_event(UART_UNIT);
+    start_s = now_s();
+    if (start_ExtPack_paced_send(UART_UNIT, buffer, amount_paced, paced_gap_us) == EXT_PACK_SUCCESS) {
+        while (!get_ExtPack_paced_send_event(UART_UNIT) && now_s() - start_s < 1.0) {
+            dispatch_ExtPack_received();
+            usleep(100);
+        }
+    }
+    double paced_duration_s = now_s() - start_s;
+    wait_for_uart_bytes(amount_paced);
+    report("paced send (200 us gap)", amount_paced, uart_bytes_received, paced_duration_s, 1);
+#endif
+
+    // ---------- SRAM write of all addresses, then read back (address bytes may be zero) ----------
+    uint32_t amount_sram = amount / 10;
+    amount_ok = 0;
+    start_s = now_s();
+    for (uint32_t i = 0; i < amount_sram; i++) {
+        write_ExtPack_SRAM_data_to_address(SRAM_UNIT, (i * 0x0101UL) & 0x7FFFF, (uint8_t)(i * 7), get_ExtPack_send_duration_us());
+    }
+    for (uint32_t i = 0; i < amount_sram; i++) {
+        uint8_t recv_data = 0;
+        clear_ExtPack_event(SRAM_UNIT);
+        if (read_ExtPack_SRAM_data_from_address(SRAM_UNIT, (i * 0x0101UL) & 0x7FFFF, &recv_data, get_ExtPack_send_duration_us(), 10000) == EXT_PACK_SUCCESS
+            && recv_data == (uint8_t)(i * 7)) {
+            amount_ok++;
+        }
+    }
+    report("SRAM write + read", amount_sram, amount_ok, now_s() - start_s, 10);
+
+    // ---------- Transactions (4 UART bytes at once, never split by the retries) ----------
+    uint32_t amount_transactions = (amount + 3) / 4;
+    amount_ok = 0;
+    uart_bytes_received = 0;
+    start_s = now_s();
+    for (uint32_t i = 0; i < amount_transactions; i++) {
+        const ext_pack_command_t commands[] = { { UART_UNIT, 't' }, { UART_UNIT, 'x' }, { UART_UNIT, 'n' }, { UART_UNIT, (uint8_t)i } };
+        amount_ok += send_transaction_to_ExtPack(commands, 4, 10000) == EXT_PACK_SUCCESS;
+        dispatch_ExtPack_received();
+    }
+    wait_for_uart_bytes(amount_transactions * 4);
+    report("send_transaction_to_ExtPack", amount_transactions, amount_ok, now_s() - start_s, 4);
+
+    // ---------- GPIO output burst (stale values are replaced in the send buffer with EXT_PACK_TX_COALESCING = 1) ----------
+    reset_ExtPack_link_stats();
+    start_s = now_s();
+    for (uint32_t i = 0; i < amount; i++) {
+        while (set_ExtPack_gpio_out(GPIO_UNIT, (uint8_t)i) != EXT_PACK_SUCCESS);
+    }
+    flush_ExtPack_tx(10000);
+    report("set_ExtPack_gpio_out burst", amount, amount, now_s() - start_s, 1);
+#if EXT_PACK_LINK_STATS
+    get_ExtPack_link_stats(&stats);
+    printf("%-28s %8" PRIu32 " sent %8" PRIu32 " coalesced\n", "", stats.frames_sent, stats.tx_coalesced);
+#endif
+
+    // ---------- ACK round trips ----------
+    uint32_t amount_ack = amount / 10;
+    amount_ok = 0;
+    clear_ExtPack_ack_event();
+    set_ExtPack_ACK_enable(1);
+    wait_for_ExtPack_ACK_data(1, 10000);
+    start_s = now_s();
+    for (uint32_t i = 0; i < amount_ack; i++) {
+        clear_ExtPack_ack_event();
+        set_ExtPack_gpio_out(GPIO_UNIT, (uint8_t)i);
+        amount_ok += wait_for_ExtPack_ACK_data((uint8_t)i, 10000) == EXT_PACK_SUCCESS;
+    }
+    report("ACK round trip", amount_ack, amount_ok, now_s() - start_s, 2);
+
+    // ---------- ACK round trips with the adaptive timeout ----------
+    ext_pack_ack_rtt_t rtt;
+    reset_ExtPack_ACK_rtt();
+    amount_ok = 0;
+    start_s = now_s();
+    for (uint32_t i = 0; i < amount_ack; i++) {
+        amount_ok += send_ExtPack_acknowledged(GPIO_UNIT, 0b00, (uint8_t)i, 3) == EXT_PACK_SUCCESS;
+    }
+    report("send_ExtPack_acknowledged", amount_ack, amount_ok, now_s() - start_s, 2);
+    get_ExtPack_ACK_rtt(EXTPACK_GPIO_UNIT, &rtt);
+    printf("%-28s %8u us srtt %8u us rttvar %8u us timeout\n", "", rtt.srtt_us, rtt.rttvar_us, rtt.timeout_us);
+
+    // ---------- Acknowledged GPIO outputs with up to EXT_PACK_RELIABLE_WINDOW commands in flight ----------
+#if EXT_PACK_RELIABLE_WINDOW > 0
+    ext_pack_reliable_stats_t reliable_stats;
+    reset_ExtPack_reliable_stats();
+    init_ExtPack_reliable_send(EXT_PACK_RELIABLE_WINDOW, 0, 3, reliable_completed); // Adaptive timeout
+    start_s = now_s();
+    for (uint32_t i = 0; i < amount_ack; i++) {
+        while (queue_ExtPack_reliable_command(GPIO_UNIT, (uint8_t)i) != EXT_PACK_SUCCESS) {
+            run_ExtPack_reliable_send();
+        }
+        run_ExtPack_reliable_send();
+    }
+    flush_ExtPack_reliable_send(100000);
+    report("reliable send (window)", amount_ack, reliable_acknowledged, now_s() - start_s, 2);
+    get_ExtPack_reliable_stats(&reliable_stats);
+    printf("%-28s %8u retransmitted %8u timeouts %8u unmatched ACKs\n", "", reliable_stats.retransmissions,
+           reliable_stats.timeouts, reliable_stats.unmatched_acks);
+    set_ExtPack_custom_ISR(unit_U02, NULL);
+#endif
+    set_ExtPack_ACK_enable(0);
+    wait_for_ExtPack_ACK_data(0, 10000);
+
+    // ---------- Link statistics of the library (since the GPIO burst) ----------
+#if EXT_PACK_LINK_STATS
+    get_ExtPack_link_stats(&stats);
+    printf("Link: %" PRIu32 " sent, %" PRIu32 " received, %" PRIu32 " TX full, TX high-water %u, %" PRIu32 " resyncs, %" PRIu32 " invalid units, %" PRIu32 " RX queue full\n",
+           stats.frames_sent, stats.frames_received, stats.tx_queue_full, stats.tx_high_water,
+           stats.resyncs, stats.invalid_units, stats.rx_queue_full);
+#endif
+    return EXIT_SUCCESS;
+}